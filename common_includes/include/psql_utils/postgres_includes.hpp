@@ -21,11 +21,16 @@ extern "C" {
 #include <catalog/pg_attribute.h>
 #include <catalog/pg_type.h>
 
+#include <common/hashfn.h>
+
 #include <fmgr.h>
 #include <funcapi.h>
 #include <miscadmin.h>
 
+#include <access/xact.h>
+#include <commands/trigger.h>
 #include <executor/spi.h>
+#include <lib/stringinfo.h>
 #include <libpq-fe.h>
 #include <access/sysattr.h>
 
@@ -37,6 +42,8 @@ extern "C" {
 #include <utils/fmgroids.h>
 #include <utils/jsonb.h>
 #include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <utils/numeric.h>
 
 #include <utils/rel.h>
 #include <utils/tuplestore.h>
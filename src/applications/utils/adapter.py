@@ -6,6 +6,7 @@ from collections import OrderedDict
 from funcy.seqs import first
 import sqlalchemy
 import os
+import select
 
 logging.getLogger('sqlalchemy.engine').setLevel(logging.WARNING)
 
@@ -54,6 +55,7 @@ class Db:
         self._engine = None
         self._trx_active = False
         self._prep_sql = {}
+        self._listen_conn = None
 
         self.name = name
 
@@ -80,6 +82,10 @@ class Db:
                     item['connection'].close()
                     item = None
             self._conn = []
+            if self._listen_conn is not None:
+                log.info("Closing database connection: '{} listen'".format(self.name))
+                self._listen_conn.close()
+                self._listen_conn = None
         except Exception as ex:
             log.exception("Error during connections closing: {}".format(ex))
             raise ex
@@ -117,6 +123,30 @@ class Db:
         self._conn.append( { "connection" : self.engine().connect(), "name" : name } )
         return self.get_connection(len(self._conn) - 1)
 
+    def listen(self, channel):
+        """Start to listen on a notification channel with a dedicated connection.
+
+        Notifications are delivered only outside of transactions, so the connection works in autocommit mode.
+        """
+        if self._listen_conn is None:
+            self._listen_conn = self.engine().raw_connection()
+            self._listen_conn.connection.autocommit = True
+        self._listen_conn.cursor().execute("LISTEN {};".format(channel))
+
+    def wait_for_notification(self, timeout):
+        """Block until a notification arrives on a listened channel or `timeout` seconds pass.
+
+        Returns True when a notification was received.
+        """
+        assert self._listen_conn is not None, "listen was never called"
+        _conn = self._listen_conn.connection
+        _conn.poll()
+        if not _conn.notifies and select.select([_conn], [], [], timeout) != ([], [], []):
+            _conn.poll()
+        _received = len(_conn.notifies) > 0
+        _conn.notifies.clear()
+        return _received
+
     def get_dialect(self):
         return self.get_connection(0).dialect
 
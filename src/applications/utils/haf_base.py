@@ -32,6 +32,9 @@ if not logger.hasHandlers():
 
 INTERRUPTED = False
 
+#maximum time[s] of waiting for a notification about a new event, an interruption is checked after it
+EVENT_WAIT_TIMEOUT = 5
+
 class haf_base(ABC):
   def __init__(self, sql = None):
     super(haf_base, self).__init__()
@@ -194,6 +197,9 @@ class haf_base(ABC):
 
         _first_block, _last_block = self.get_blocks()
         if _first_block is None:
+          #nothing to process, sleep until hived notifies about a new event
+          if not self.is_interrupted():
+            self.sql.wait_for_next_event(EVENT_WAIT_TIMEOUT)
           return True
 
         self.is_massive = _last_block - _first_block + 1 > helper.args.massive_threshold
@@ -19,6 +19,10 @@ class haf_query:
     self.context_current_block_num        = "SELECT current_block_num FROM hive.contexts WHERE NAME = '{}'".format( self.application_context )
     
     self.next_block                       = "SELECT * FROM hive.app_next_block('{}');".format( self.application_context )
+    self.has_next_event                   = "SELECT hive.app_has_next_event('{}');".format( self.application_context )
+
+    #hived notifies about each new block, irreversible block, fork and the end of massive sync on this channel
+    self.events_channel                   = "hive_events"
 
 class haf_sql:
   def __init__(self, application_context):
@@ -28,6 +32,8 @@ class haf_sql:
 
     self.text_query = haf_query(application_context)
 
+    self.db.listen(self.text_query.events_channel)
+
   def exec_query(self, query, **kwargs):
     with timer("query time[ms]: {}") as tm:
       helper.display_query(query, **kwargs)
@@ -78,6 +84,13 @@ class haf_sql:
   def exec_next_block(self):
     return self.exec_query_all(self.text_query.next_block)
 
+  def wait_for_next_event(self, timeout):
+    """Block until hived adds a new event or `timeout` seconds pass, instead of calling `hive.app_next_block` in a loop"""
+    #an event added before the previous notification was consumed has to be found without waiting
+    if self.exec_query_one(self.text_query.has_next_event):
+      return True
+    return self.db.wait_for_notification(timeout)
+
   def get_last_block_num(self):
     _result = self.exec_context_detached_get_block_num()
     if _result is None:
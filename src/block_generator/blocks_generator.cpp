@@ -0,0 +1,327 @@
+#include "blocks_generator.hpp"
+
+#include <fc/bitutil.hpp>
+#include <fc/exception/exception.hpp>
+
+#include <boost/core/demangle.hpp>
+
+#include <cmath>
+#include <map>
+#include <typeinfo>
+
+namespace block_generator {
+
+namespace {
+
+  using hive::protocol::operation;
+
+  constexpr uint32_t GENESIS_TIME = 1458835200;
+  constexpr uint32_t BLOCK_INTERVAL_SECONDS = 3;
+  constexpr uint32_t WITNESSES_NUMBER = 21;
+  const std::string ACCOUNT_NAME_CHARACTERS = "abcdefghijklmnopqrstuvwxyz0123456789.-";
+  const std::string ACCOUNT_NAME_FIRST_CHARACTERS = "abcdefghijklmnopqrstuvwxyz";
+  const std::string PERMLINK_CHARACTERS = "abcdefghijklmnopqrstuvwxyz0123456789-";
+  const std::string MEMO_CHARACTERS = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789#:_%'";
+
+  struct operation_name_visitor
+  {
+    using result_type = std::string;
+
+    template< typename Operation >
+    std::string operator()( const Operation& ) const
+    {
+      const std::string name = boost::core::demangle( typeid( Operation ).name() );
+      return name.substr( name.rfind( ':' ) + 1 );
+    }
+  };
+
+  const std::map< std::string, int64_t >& operation_types()
+  {
+    static const auto types = [] {
+      std::map< std::string, int64_t > result;
+      for ( int64_t type_id = 0; type_id < operation::count(); ++type_id )
+      {
+        operation op;
+        op.set_which( type_id );
+        result.emplace( operation_name( op ), type_id );
+      }
+      return result;
+    }();
+    return types;
+  }
+
+} // namespace
+
+std::string operation_name( const operation& op )
+{
+  return op.visit( operation_name_visitor() );
+}
+
+int64_t operation_type_id( const std::string& name )
+{
+  const auto it = operation_types().find( name );
+  FC_ASSERT( it != operation_types().end(), "Unknown operation type ${n}", ("n", name) );
+  return it->second;
+}
+
+bool is_virtual_operation_type( int64_t type_id )
+{
+  static const auto virtual_types = [] {
+    std::vector< bool > result;
+    for ( int64_t id = 0; id < operation::count(); ++id )
+    {
+      operation op;
+      op.set_which( id );
+      result.push_back( hive::protocol::is_virtual_operation( op ) );
+    }
+    return result;
+  }();
+  FC_ASSERT( type_id >= 0 && type_id < operation::count(), "Unknown operation type id ${id}", ("id", type_id) );
+  return virtual_types[ type_id ];
+}
+
+blocks_generator::blocks_generator( generator_profile profile, uint32_t seed, uint32_t first_block )
+  : _profile( std::move( profile ) )
+  , _random( seed )
+  , _next_block_num( first_block )
+{
+  FC_ASSERT( first_block > 0, "Blocks are numbered from 1" );
+  FC_ASSERT( _profile.accounts >= WITNESSES_NUMBER, "Profile requires at least ${w} accounts", ("w", WITNESSES_NUMBER) );
+
+  // block number is encoded in the first 4 bytes of a block id
+  _previous_block_id._hash[ 0 ] = fc::endian_reverse_u32( first_block - 1 );
+
+  std::vector< double > activity;
+  activity.reserve( _profile.accounts );
+  for ( uint32_t rank = 1; rank <= _profile.accounts; ++rank )
+    activity.push_back( 1.0 / std::pow( rank, _profile.account_activity_skew ) );
+  _account_activity = std::discrete_distribution< uint32_t >( activity.begin(), activity.end() );
+
+  std::vector< uint64_t > weights;
+  bool has_non_virtual_operation = false;
+  for ( const auto& operation_weight : _profile.operations_mix )
+  {
+    const auto type_id = operation_type_id( operation_weight.first );
+    if ( operation_weight.second == 0 )
+      continue;
+    _mix_types.push_back( type_id );
+    weights.push_back( operation_weight.second );
+    has_non_virtual_operation |= !is_virtual_operation_type( type_id );
+  }
+  FC_ASSERT( has_non_virtual_operation || _profile.transactions_per_block.max == 0, "Operations mix does not contain any non-virtual operation which could fill transactions" );
+  _mix = std::discrete_distribution< uint32_t >( weights.begin(), weights.end() );
+}
+
+generated_block blocks_generator::next_block( bool complete_operation_types )
+{
+  generated_block result;
+  result.block_num = _next_block_num++;
+
+  auto& block = result.block;
+  block.previous = _previous_block_id;
+  block.timestamp = fc::time_point_sec( GENESIS_TIME + result.block_num * BLOCK_INTERVAL_SECONDS );
+
+  if ( _accounts.empty() )
+  {
+    for ( uint32_t i = 0; i < _profile.accounts; ++i )
+    {
+      _accounts.push_back( new_account_name() );
+      result.new_accounts.push_back( _accounts.back() );
+    }
+  }
+  block.witness = _accounts[ random_number( { 0, WITNESSES_NUMBER - 1 } ) ];
+
+  const auto transactions_number = random_number( _profile.transactions_per_block );
+  for ( uint32_t trx_in_block = 0; trx_in_block < transactions_number; ++trx_in_block )
+  {
+    hive::protocol::signed_transaction trx;
+    const auto operations_number = random_chance( _profile.multi_operation_transactions )
+      ? random_number( { _profile.operations_per_transaction.min + 1, _profile.operations_per_transaction.max } )
+      : _profile.operations_per_transaction.min;
+
+    // virtual operations drawn from the mix go to the block, so the loop counts only operations in the transaction
+    while ( trx.operations.size() < std::max( operations_number, 1u ) )
+      add_operation( _mix_types[ _mix( _random ) ], result, trx );
+
+    add_transaction( std::move( trx ), result );
+  }
+
+  if ( _profile.cover_all_operation_types || complete_operation_types )
+  {
+    // one operation of the next type, or all types remaining in the current cycle of types
+    do
+    {
+      hive::protocol::signed_transaction trx;
+      add_operation( _next_operation_type, result, trx );
+      _next_operation_type = ( _next_operation_type + 1 ) % operation::count();
+      if ( !trx.operations.empty() )
+        add_transaction( std::move( trx ), result );
+    } while ( complete_operation_types && _next_operation_type != 0 );
+  }
+
+  block.transaction_merkle_root = block.calculate_merkle_root();
+  block.witness_signature = random_signature();
+  _previous_block_id = block.id();
+
+  return result;
+}
+
+void blocks_generator::add_operation( int64_t type_id, generated_block& block, hive::protocol::signed_transaction& trx )
+{
+  auto op = create_operation( type_id, block );
+  if ( is_virtual_operation_type( type_id ) )
+    block.virtual_operations.push_back( std::move( op ) );
+  else
+    trx.operations.push_back( std::move( op ) );
+}
+
+void blocks_generator::add_transaction( hive::protocol::signed_transaction&& trx, generated_block& block )
+{
+  trx.ref_block_num = static_cast< uint16_t >( ( block.block_num - 1 ) & 0xffff );
+  trx.ref_block_prefix = _random();
+  trx.expiration = block.block.timestamp + 60;
+
+  trx.signatures.push_back( random_signature() );
+  if ( random_chance( _profile.multisig_transactions ) )
+    trx.signatures.push_back( random_signature() );
+
+  block.block.transactions.push_back( std::move( trx ) );
+}
+
+operation blocks_generator::create_operation( int64_t type_id, generated_block& block )
+{
+  if ( type_id == operation::tag< hive::protocol::vote_operation >::value )
+  {
+    hive::protocol::vote_operation vote;
+    vote.voter = random_account();
+    vote.author = random_account();
+    vote.permlink = random_text( random_number( _profile.permlink_length ), PERMLINK_CHARACTERS );
+    vote.weight = static_cast< int16_t >( std::uniform_int_distribution< int32_t >( -10000, 10000 )( _random ) );
+    return vote;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::custom_json_operation >::value )
+  {
+    hive::protocol::custom_json_operation custom_json;
+    const auto& follower = random_account();
+    custom_json.required_posting_auths.insert( follower );
+    custom_json.id = std::string( random_chance( 0.5 ) ? "follow" : "sm_market_purchase" );
+    custom_json.json = "[\"follow\",{\"follower\":\"" + follower + "\",\"following\":\"" + random_account() + "\",\"what\":[\"blog\"]";
+    const auto length = random_number( _profile.custom_json_length );
+    if ( custom_json.json.size() + 14 < length )
+      custom_json.json += ",\"memo\":\"" + random_text( length - custom_json.json.size() - 14, PERMLINK_CHARACTERS ) + "\"";
+    custom_json.json += "}]";
+    return custom_json;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::transfer_operation >::value )
+  {
+    hive::protocol::transfer_operation transfer;
+    transfer.from = random_account();
+    transfer.to = random_account();
+    transfer.amount = hive::protocol::asset( random_number( { 1, 1'000'000 } ), HIVE_SYMBOL );
+    transfer.memo = random_text( random_number( _profile.memo_length ), MEMO_CHARACTERS );
+    return transfer;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::comment_operation >::value )
+  {
+    hive::protocol::comment_operation comment;
+    comment.parent_author = random_account();
+    comment.parent_permlink = random_text( random_number( _profile.permlink_length ), PERMLINK_CHARACTERS );
+    comment.author = random_account();
+    comment.permlink = random_text( random_number( _profile.permlink_length ), PERMLINK_CHARACTERS );
+    comment.title = random_text( random_number( { 0, 80 } ), MEMO_CHARACTERS );
+    comment.body = random_body( random_number( _profile.comment_body_length ) );
+    comment.json_metadata = "{\"tags\":[\"hive\",\"photography\"],\"app\":\"peakd/2023.1.1\",\"format\":\"markdown\"}";
+    return comment;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::comment_options_operation >::value )
+  {
+    hive::protocol::comment_options_operation options;
+    options.author = random_account();
+    options.permlink = random_text( random_number( _profile.permlink_length ), PERMLINK_CHARACTERS );
+    options.allow_curation_rewards = random_chance( 0.9 );
+    return options;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::account_create_operation >::value )
+  {
+    hive::protocol::account_create_operation create;
+    create.fee = hive::protocol::asset( 3000, HIVE_SYMBOL );
+    create.creator = random_account();
+    create.new_account_name = new_account_name();
+    _accounts.push_back( create.new_account_name );
+    block.new_accounts.push_back( create.new_account_name );
+    return create;
+  }
+
+  if ( type_id == operation::tag< hive::protocol::create_claimed_account_operation >::value )
+  {
+    hive::protocol::create_claimed_account_operation create;
+    create.creator = random_account();
+    create.new_account_name = new_account_name();
+    _accounts.push_back( create.new_account_name );
+    block.new_accounts.push_back( create.new_account_name );
+    return create;
+  }
+
+  // the other types have default values, they differ from mainnet by sizes only
+  operation op;
+  op.set_which( type_id );
+  return op;
+}
+
+std::string blocks_generator::random_text( uint32_t length, const std::string& alphabet )
+{
+  std::string text( length, ' ' );
+  for ( auto& c : text )
+    c = alphabet[ random_number( { 0, static_cast< uint32_t >( alphabet.size() - 1 ) } ) ];
+  return text;
+}
+
+std::string blocks_generator::random_body( uint32_t length )
+{
+  // markdown with new lines, quotes and multibyte characters, which are the expensive cases of escaping
+  static const std::vector< std::string > fragments = {
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit. "
+    , "It's a \"quoted\" sentence with a backslash \\ inside.\n"
+    , "![image](https://images.hive.blog/DQm/photo.jpg)\n\n"
+    , "Zażółć gęślą jaźń. "
+    , "日本語のテキスト。"
+    , "Emoji: \xF0\x9F\x9A\x80 \xF0\x9F\x94\xA5\n"
+    , "| column | value |\r\n|---|---|\r\n| a_b | 50% |\n"
+  };
+
+  std::string body;
+  while ( body.size() < length )
+    body += fragments[ random_number( { 0, static_cast< uint32_t >( fragments.size() - 1 ) } ) ];
+  return body;
+}
+
+std::string blocks_generator::new_account_name()
+{
+  std::string name;
+  do
+  {
+    name = random_text( 1, ACCOUNT_NAME_FIRST_CHARACTERS ) + random_text( random_number( { 2, 15 } ), ACCOUNT_NAME_CHARACTERS );
+  } while ( !_used_account_names.insert( name ).second );
+  return name;
+}
+
+const std::string& blocks_generator::random_account()
+{
+  // accounts created by operations are not drawn, the activity distribution covers the initial accounts
+  return _accounts[ _account_activity( _random ) ];
+}
+
+hive::protocol::signature_type blocks_generator::random_signature()
+{
+  hive::protocol::signature_type signature;
+  for ( auto& byte : signature.data )
+    byte = static_cast< unsigned char >( _random() );
+  return signature;
+}
+
+} // namespace block_generator
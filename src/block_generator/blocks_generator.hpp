@@ -0,0 +1,78 @@
+#pragma once
+
+#include "generator_profile.hpp"
+
+#include <hive/protocol/block.hpp>
+#include <hive/protocol/operations.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace block_generator {
+
+/// Name of the operation type without namespace, e.g. `vote_operation`
+std::string operation_name( const hive::protocol::operation& op );
+
+/// Operation type id (operation::which()) for the name of the operation type, FC_ASSERTs when the name is unknown
+int64_t operation_type_id( const std::string& name );
+
+bool is_virtual_operation_type( int64_t type_id );
+
+struct generated_block
+{
+  uint32_t                                 block_num = 0;
+  hive::protocol::signed_block             block;
+  /// virtual operations which hived would produce while applying the block
+  std::vector< hive::protocol::operation > virtual_operations;
+  /// accounts which start to exist in the block, the first block contains all initial accounts
+  std::vector< std::string >               new_accounts;
+};
+
+/**
+ * Produces a deterministic stream of blocks shaped by a generator_profile. Blocks are linked by ids,
+ * transactions have random signatures, so only blocks structure and sizes are realistic, not their validity.
+ */
+class blocks_generator
+{
+public:
+  blocks_generator( generator_profile profile, uint32_t seed, uint32_t first_block );
+
+  /// with complete_operation_types the block also gets operations of all types which have not occurred in the current cycle of types
+  generated_block next_block( bool complete_operation_types = false );
+
+  uint32_t next_block_num() const { return _next_block_num; }
+  const std::vector< std::string >& accounts() const { return _accounts; }
+
+private:
+  void add_operation( int64_t type_id, generated_block& block, hive::protocol::signed_transaction& trx );
+  hive::protocol::operation create_operation( int64_t type_id, generated_block& block );
+  void add_transaction( hive::protocol::signed_transaction&& trx, generated_block& block );
+
+  uint32_t random_number( const range& r ) { return std::uniform_int_distribution< uint32_t >( r.min, std::max( r.min, r.max ) )( _random ); }
+  bool     random_chance( double probability ) { return std::bernoulli_distribution( probability )( _random ); }
+  std::string random_text( uint32_t length, const std::string& alphabet );
+  std::string random_body( uint32_t length );
+  std::string new_account_name();
+  const std::string& random_account();
+  hive::protocol::signature_type random_signature();
+
+private:
+  const generator_profile                 _profile;
+  std::mt19937                            _random;
+  uint32_t                                _next_block_num;
+  hive::protocol::block_id_type           _previous_block_id;
+  std::vector< std::string >              _accounts;
+  std::set< std::string >                 _used_account_names;
+  std::discrete_distribution< uint32_t >  _account_activity;
+  std::vector< int64_t >                  _mix_types;
+  std::discrete_distribution< uint32_t >  _mix;
+  int64_t                                 _next_operation_type = 0;
+};
+
+} // namespace block_generator
+
+FC_REFLECT( block_generator::generated_block, (block_num)(block)(virtual_operations)(new_accounts) )
@@ -0,0 +1,145 @@
+#include "corpus.hpp"
+
+#include <hive/chain/util/impacted.hpp>
+
+#include <fc/io/json.hpp>
+
+namespace block_generator {
+
+namespace {
+
+  constexpr uint32_t HARDFORKS_NUMBER = 28;
+  constexpr uint32_t BLOCKS_BETWEEN_HARDFORKS = 1000;
+
+  /// collects texts of operations which are escaped by converters
+  struct texts_visitor
+  {
+    using result_type = void;
+
+    std::vector< std::string >& texts;
+
+    void operator()( const hive::protocol::vote_operation& op ) const
+    {
+      texts.push_back( op.voter );
+      texts.push_back( op.author );
+      texts.push_back( op.permlink );
+    }
+
+    void operator()( const hive::protocol::comment_operation& op ) const
+    {
+      texts.push_back( op.permlink );
+      texts.push_back( op.title );
+      texts.push_back( op.body );
+      texts.push_back( op.json_metadata );
+    }
+
+    void operator()( const hive::protocol::custom_json_operation& op ) const
+    {
+      texts.push_back( op.json );
+    }
+
+    void operator()( const hive::protocol::transfer_operation& op ) const
+    {
+      texts.push_back( op.memo );
+    }
+
+    template< typename Operation >
+    void operator()( const Operation& ) const {}
+  };
+
+} // namespace
+
+corpus_generator::corpus_generator( generator_profile profile, uint32_t seed, uint32_t first_block )
+  : _blocks( std::move( profile ), seed, first_block )
+{
+}
+
+void corpus_generator::generate( uint32_t blocks_number, corpus& result, bool complete_operation_types )
+{
+  for ( uint32_t i = 0; i < blocks_number; ++i )
+  {
+    const bool is_last_block = i + 1 == blocks_number;
+    add_block( _blocks.next_block( complete_operation_types && is_last_block ), result );
+  }
+}
+
+void corpus_generator::add_block( const generated_block& generated, corpus& result )
+{
+  const auto& block = generated.block;
+  const int32_t block_num = static_cast< int32_t >( generated.block_num );
+
+  for ( const auto& name : generated.new_accounts )
+  {
+    const int32_t id = static_cast< int32_t >( _account_ids.size() );
+    _account_ids.emplace( name, id );
+    result.accounts.emplace_back( id, name, block_num );
+    result.texts.push_back( name );
+  }
+
+  for ( size_t trx_in_block = 0; trx_in_block < block.transactions.size(); ++trx_in_block )
+  {
+    const auto& trx = block.transactions[ trx_in_block ];
+    const auto trx_id = trx.id();
+
+    fc::optional< hive::protocol::signature_type > signature;
+    if ( !trx.signatures.empty() )
+      signature = trx.signatures.front();
+    result.transactions.emplace_back( trx_id, block_num, static_cast< int32_t >( trx_in_block ), trx.ref_block_num, trx.ref_block_prefix, trx.expiration, signature );
+
+    for ( size_t i = 1; i < trx.signatures.size(); ++i )
+      result.transactions_multisig.emplace_back( trx_id, block_num, trx.signatures[ i ] );
+
+    for ( size_t op_in_trx = 0; op_in_trx < trx.operations.size(); ++op_in_trx )
+      add_operation( trx.operations[ op_in_trx ], block_num, static_cast< int32_t >( trx_in_block ), static_cast< int32_t >( op_in_trx ), block.timestamp, result );
+  }
+
+  // virtual operations are put at the end of block like in hived
+  for ( size_t op_in_block = 0; op_in_block < generated.virtual_operations.size(); ++op_in_block )
+    add_operation( generated.virtual_operations[ op_in_block ], block_num, -1, static_cast< int32_t >( op_in_block ), block.timestamp, result );
+
+  if ( generated.block_num % BLOCKS_BETWEEN_HARDFORKS == 0 && _applied_hardforks < HARDFORKS_NUMBER && _operation_id > 0 )
+    result.applied_hardforks.emplace_back( ++_applied_hardforks, block_num, _operation_id );
+
+  hive::protocol::VEST_asset vests;
+  vests.amount = 300'000'000'000'000'000;
+  hive::protocol::HIVE_asset liquid;
+  liquid.amount = 400'000'000'000;
+  hive::protocol::HBD_asset hbd;
+  hbd.amount = 30'000'000'000;
+
+  fc::optional< std::string > extensions;
+  if ( !block.extensions.empty() )
+    extensions = fc::json::to_string( block.extensions );
+
+  result.blocks.emplace_back( block.id(), block_num, block.timestamp, block.previous, _account_ids.at( block.witness )
+    , block.transaction_merkle_root, extensions, block.witness_signature, hive::protocol::public_key_type()
+    , 2000, vests, liquid, liquid, liquid, liquid, hbd, hbd );
+}
+
+void corpus_generator::add_operation( const hive::protocol::operation& op, int32_t block_num, int32_t trx_in_block, int32_t op_in_trx, const fc::time_point_sec& timestamp, corpus& result )
+{
+  ++_operation_id;
+  result.operations.emplace_back( _operation_id, block_num, trx_in_block, op_in_trx, timestamp, op );
+  op.visit( texts_visitor{ result.texts } );
+
+  boost::container::flat_set< hive::protocol::account_name_type > impacted;
+  hive::app::operation_get_impacted_accounts( op, impacted );
+  for ( const auto& account : impacted )
+  {
+    const auto account_it = _account_ids.find( account );
+    if ( account_it == _account_ids.end() )
+      continue;
+
+    const auto account_id = account_it->second;
+    result.account_operations.emplace_back( block_num, _operation_id, account_id, _account_operations_count[ account_id ]++, op.which() );
+  }
+}
+
+corpus generate_corpus( const generator_profile& profile, uint32_t blocks_number, uint32_t seed, uint32_t first_block )
+{
+  corpus result;
+  corpus_generator( profile, seed, first_block ).generate( blocks_number, result, true );
+  return result;
+}
+
+} // namespace block_generator
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "blocks_generator.hpp"
+
+#include <hive/plugins/sql_serializer/sql_serializer_objects.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace block_generator {
+
+namespace objects = hive::plugins::sql_serializer::PSQL::processing_objects;
+
+/// Rows of all irreversible HAF tables in the form in which sql_serializer caches them before dumping
+struct corpus
+{
+  std::vector< objects::process_block_t >                blocks;
+  std::vector< objects::process_transaction_t >          transactions;
+  std::vector< objects::process_transaction_multisig_t > transactions_multisig;
+  std::vector< objects::process_operation_t >            operations;
+  std::vector< objects::account_data_t >                 accounts;
+  std::vector< objects::account_operation_data_t >       account_operations;
+  std::vector< objects::applied_hardforks_t >            applied_hardforks;
+
+  /// texts passed through the escape kernel: account names, permlinks, memos, comment bodies and jsons
+  std::vector< std::string >                             texts;
+};
+
+/**
+ * Converts blocks of the blocks_generator to rows, block after block, so a long stream of blocks can be produced
+ * without keeping all of them in memory. Rows are consistent with constraints of the HAF irreversible tables:
+ * identifiers and account names are unique and every referenced account, operation or transaction exists.
+ * Accounts impacted by operations are found in the same way as sql_serializer does it.
+ */
+class corpus_generator
+{
+public:
+  corpus_generator( generator_profile profile, uint32_t seed, uint32_t first_block );
+
+  /// appends rows of the next blocks_number blocks to the result, see blocks_generator::next_block for complete_operation_types
+  void generate( uint32_t blocks_number, corpus& result, bool complete_operation_types = false );
+
+  uint32_t next_block() const { return _blocks.next_block_num(); }
+
+private:
+  void add_block( const generated_block& block, corpus& result );
+  void add_operation( const hive::protocol::operation& op, int32_t block_num, int32_t trx_in_block, int32_t op_in_trx, const fc::time_point_sec& timestamp, corpus& result );
+
+private:
+  blocks_generator                            _blocks;
+  std::unordered_map< std::string, int32_t >  _account_ids;
+  std::map< int32_t, int32_t >                _account_operations_count;
+  int64_t                                     _operation_id = 0;
+  uint32_t                                    _applied_hardforks = 0;
+};
+
+/// Rows of blocks_number blocks which contain all operation types
+corpus generate_corpus( const generator_profile& profile, uint32_t blocks_number, uint32_t seed, uint32_t first_block = 60'000'000 );
+
+} // namespace block_generator
@@ -0,0 +1,119 @@
+#include "generator_profile.hpp"
+#include "blocks_generator.hpp"
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include <fstream>
+#include <vector>
+
+namespace block_generator {
+
+generator_profile mainnet_profile()
+{
+  generator_profile profile;
+  profile.accounts = 100'000;
+  profile.account_activity_skew = 1.1;
+  profile.transactions_per_block = { 0, 80 };
+  profile.operations_per_transaction = { 1, 5 };
+  profile.multi_operation_transactions = 0.1;
+  profile.multisig_transactions = 0.02;
+  profile.permlink_length = { 10, 60 };
+  profile.memo_length = { 0, 120 };
+  profile.comment_body_length = { 200, 8000 };
+  profile.custom_json_length = { 60, 400 };
+  profile.cover_all_operation_types = false;
+
+  // numbers of operations per 10000 operations
+  profile.operations_mix = {
+      { "custom_json_operation", 4300 }
+    , { "vote_operation", 2000 }
+    , { "effective_comment_vote_operation", 2000 }
+    , { "curation_reward_operation", 500 }
+    , { "transfer_operation", 250 }
+    , { "comment_operation", 200 }
+    , { "limit_order_create_operation", 90 }
+    , { "fill_order_operation", 60 }
+    , { "claim_reward_balance_operation", 100 }
+    , { "comment_options_operation", 60 }
+    , { "limit_order_cancel_operation", 40 }
+    , { "author_reward_operation", 40 }
+    , { "comment_reward_operation", 40 }
+    , { "comment_payout_update_operation", 40 }
+    , { "producer_reward_operation", 100 }
+    , { "feed_publish_operation", 30 }
+    , { "transfer_to_vesting_operation", 20 }
+    , { "transfer_to_vesting_completed_operation", 20 }
+    , { "delegate_vesting_shares_operation", 10 }
+    , { "account_update2_operation", 10 }
+    , { "account_witness_vote_operation", 5 }
+    , { "claim_account_operation", 5 }
+    , { "create_claimed_account_operation", 5 }
+    , { "account_created_operation", 5 }
+    , { "account_create_operation", 1 }
+  };
+
+  return profile;
+}
+
+generator_profile load_profile( const std::string& path )
+{
+  auto profile = mainnet_profile();
+  fc::from_variant( fc::json::from_file( path ), profile );
+  return profile;
+}
+
+void apply_day_stats( generator_profile& profile, const std::string& csv_path )
+{
+  std::ifstream csv( csv_path );
+  FC_ASSERT( csv.is_open(), "Cannot open ${f}", ("f", csv_path) );
+
+  std::string line;
+  FC_ASSERT( std::getline( csv, line ), "${f} is empty", ("f", csv_path) );
+  std::vector< std::string > columns;
+  boost::split( columns, line, boost::is_any_of( ",\r" ) );
+
+  std::vector< uint64_t > counts( columns.size(), 0 );
+  while ( std::getline( csv, line ) )
+  {
+    std::vector< std::string > values;
+    boost::split( values, line, boost::is_any_of( ",\r" ) );
+    // the first column is block_day
+    for ( size_t column = 1; column < values.size() && column < columns.size(); ++column )
+    {
+      if ( !values[ column ].empty() )
+        counts[ column ] += std::stoull( values[ column ] );
+    }
+  }
+
+  uint64_t stats_total = 0;
+  for ( size_t column = 1; column < columns.size(); ++column )
+    stats_total += counts[ column ];
+  FC_ASSERT( stats_total > 0, "${f} does not contain any operation", ("f", csv_path) );
+
+  uint64_t profile_non_virtual_total = 0;
+  for ( auto it = profile.operations_mix.begin(); it != profile.operations_mix.end(); )
+  {
+    if ( is_virtual_operation_type( operation_type_id( it->first ) ) )
+    {
+      ++it;
+      continue;
+    }
+    profile_non_virtual_total += it->second;
+    it = profile.operations_mix.erase( it );
+  }
+
+  for ( size_t column = 1; column < columns.size(); ++column )
+  {
+    if ( columns[ column ].empty() || counts[ column ] == 0 )
+      continue;
+    operation_type_id( columns[ column ] ); // asserts the column is an operation name
+    // at least 1 to not lose rare operations in the scaling
+    profile.operations_mix[ columns[ column ] ] = std::max< uint64_t >( 1, counts[ column ] * profile_non_virtual_total / stats_total );
+  }
+}
+
+} // namespace block_generator
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <fc/reflect/reflect.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace block_generator {
+
+struct range
+{
+  uint32_t min = 0;
+  uint32_t max = 0;
+};
+
+/**
+ * Shape of generated blocks. Numbers are drawn uniformly from ranges, operation types are drawn with weights
+ * of operations_mix (keys are names of hive::protocol operations, e.g. `vote_operation`), accounts are drawn
+ * with Zipf distribution, so a few accounts are much more active than the others like on mainnet.
+ */
+struct generator_profile
+{
+  uint32_t accounts = 0;
+  /// exponent of Zipf distribution of accounts activity, 0 means all accounts are equally active
+  double   account_activity_skew = 0.0;
+  range    transactions_per_block;
+  range    operations_per_transaction;
+  /// probability that a transaction has more than operations_per_transaction.min operations
+  double   multi_operation_transactions = 0.0;
+  /// probability that a transaction has more than one signature
+  double   multisig_transactions = 0.0;
+  range    permlink_length;
+  range    memo_length;
+  range    comment_body_length;
+  range    custom_json_length;
+  /// each block gets one more operation of the next type, so all types occur after operation::count() blocks
+  bool     cover_all_operation_types = false;
+  std::map< std::string, uint64_t > operations_mix;
+};
+
+/// Profile modelled on mainnet blocks from 2023
+generator_profile mainnet_profile();
+
+/// Loads a profile from a JSON file, not specified fields are taken from the mainnet profile
+generator_profile load_profile( const std::string& path );
+
+/**
+ * Replaces weights of non-virtual operations with numbers of operations from CSV output of hive.block_day_stats_view,
+ * e.g. `\copy (SELECT * FROM hive.block_day_stats_view) TO 'stats.csv' CSV HEADER`. Numbers of all days are summed up
+ * and scaled, so the ratio between virtual and non-virtual operations of the profile is kept.
+ */
+void apply_day_stats( generator_profile& profile, const std::string& csv_path );
+
+} // namespace block_generator
+
+FC_REFLECT( block_generator::range, (min)(max) )
+FC_REFLECT( block_generator::generator_profile,
+  (accounts)(account_activity_skew)(transactions_per_block)(operations_per_transaction)(multi_operation_transactions)
+  (multisig_transactions)(permlink_length)(memo_length)(comment_body_length)(custom_json_length)(cover_all_operation_types)
+  (operations_mix)
+)
@@ -0,0 +1,136 @@
+#include "corpus.hpp"
+
+#include <hive/plugins/sql_serializer/tables_descriptions.h>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+  namespace sql = hive::plugins::sql_serializer;
+
+  template< typename TableDescriptor >
+  void write_insert( std::ostream& output, const typename TableDescriptor::container_t& rows )
+  {
+    if ( rows.empty() )
+      return;
+
+    typename TableDescriptor::data2sql_tuple converter;
+    output << "INSERT INTO " << TableDescriptor::TABLE << " ( " << TableDescriptor::COLS << " ) VALUES\n";
+    for ( auto it = rows.begin(); it != rows.end(); ++it )
+      output << ( it == rows.begin() ? "  (" : " ,(" ) << converter( *it ) << ")\n";
+    output << ";\n";
+  }
+
+  /// rows of a batch of blocks are inserted in one transaction, the foreign key of block producer is deferred
+  void write_sql( std::ostream& output, const block_generator::corpus& rows )
+  {
+    output << "BEGIN;\n";
+    write_insert< sql::hive_blocks >( output, rows.blocks );
+    write_insert< sql::hive_transactions< std::vector< block_generator::objects::process_transaction_t > > >( output, rows.transactions );
+    write_insert< sql::hive_transactions_multisig >( output, rows.transactions_multisig );
+    write_insert< sql::hive_operations< std::vector< block_generator::objects::process_operation_t > > >( output, rows.operations );
+    write_insert< sql::hive_accounts >( output, rows.accounts );
+    write_insert< sql::hive_account_operations< std::vector< block_generator::objects::account_operation_data_t > > >( output, rows.account_operations );
+    write_insert< sql::hive_applied_hardforks >( output, rows.applied_hardforks );
+    output << "COMMIT;\n";
+  }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Generates deterministic synthetic blocks shaped like mainnet ones" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "profile,p", po::value< std::string >(), "JSON file with a generator profile, not specified fields are taken from the mainnet profile" )
+    ( "day-stats", po::value< std::string >(), "CSV output of hive.block_day_stats_view, replaces non-virtual operations mix of the profile" )
+    ( "print-profile", "Print the effective profile as JSON and exit, it is a template for --profile" )
+    ( "first-block", po::value< uint32_t >()->default_value( 1 ), "number of the first generated block" )
+    ( "blocks,b", po::value< uint32_t >()->default_value( 1000 ), "number of generated blocks" )
+    ( "seed,s", po::value< uint32_t >()->default_value( 42 ), "seed of the generator, the same seed and profile give the same blocks" )
+    ( "format,f", po::value< std::string >()->default_value( "json" ), "json - a block per line with its virtual operations and new accounts, "
+                                                                       "sql - INSERTs into irreversible tables of a fresh HAF database" )
+    ( "batch", po::value< uint32_t >()->default_value( 1000 ), "number of blocks in one SQL transaction for the sql format" )
+    ( "output,o", po::value< std::string >(), "file to write blocks to, stdout when not set" )
+    ;
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    auto profile = args.count( "profile" ) ? block_generator::load_profile( args[ "profile" ].as< std::string >() ) : block_generator::mainnet_profile();
+    if ( args.count( "day-stats" ) )
+      block_generator::apply_day_stats( profile, args[ "day-stats" ].as< std::string >() );
+
+    if ( args.count( "print-profile" ) )
+    {
+      std::cout << fc::json::to_pretty_string( profile ) << std::endl;
+      return 0;
+    }
+
+    std::ofstream output_file;
+    if ( args.count( "output" ) )
+    {
+      output_file.open( args[ "output" ].as< std::string >() );
+      FC_ASSERT( output_file.is_open(), "Cannot open output file ${f}", ("f", args[ "output" ].as< std::string >()) );
+    }
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    const auto format = args[ "format" ].as< std::string >();
+    const auto blocks = args[ "blocks" ].as< uint32_t >();
+    const auto first_block = args[ "first-block" ].as< uint32_t >();
+    const auto seed = args[ "seed" ].as< uint32_t >();
+
+    if ( format == "json" )
+    {
+      block_generator::blocks_generator generator( profile, seed, first_block );
+      for ( uint32_t i = 0; i < blocks; ++i )
+        output << fc::json::to_string( generator.next_block() ) << '\n';
+    }
+    else if ( format == "sql" )
+    {
+      const auto batch = std::max( args[ "batch" ].as< uint32_t >(), 1u );
+      output << sql::PSQL::get_all_type_definitions( type_extractor::operation_extractor() ) << ";\n";
+
+      block_generator::corpus_generator generator( profile, seed, first_block );
+      for ( uint32_t generated = 0; generated < blocks; generated += batch )
+      {
+        block_generator::corpus rows;
+        generator.generate( std::min( batch, blocks - generated ), rows );
+        write_sql( output, rows );
+      }
+    }
+    else
+      FC_THROW( "Unknown format ${f}", ("f", format) );
+
+    ilog( "Generated ${b} blocks from ${first}", ("b", blocks)("first", first_block) );
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Generation failed: ${e}", ( "e", e.to_detail_string() ) );
+    return 1;
+  }
+
+  return 0;
+}
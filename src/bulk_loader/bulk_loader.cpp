@@ -0,0 +1,328 @@
+#include "bulk_loader.hpp"
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/time.hpp>
+
+#include <libpq-fe.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace bulk_loader {
+
+namespace {
+
+/// Tables are loaded stage by stage, a stage contains only tables whose foreign keys point to tables from previous stages
+/// ( hive.blocks -> hive.accounts is the only cycle, but it is DEFERRABLE and anyway FK-s are dropped for the load time )
+const std::vector< std::set< std::string > > LOAD_STAGES = {
+    { "blocks" }
+  , { "transactions", "operations", "accounts" }
+  , { "transactions_multisig", "applied_hardforks", "account_operations" }
+};
+
+const std::vector< std::string > IRREVERSIBLE_TABLES = {
+    "blocks"
+  , "irreversible_data"
+  , "transactions"
+  , "transactions_multisig"
+  , "operations"
+  , "accounts"
+  , "account_operations"
+  , "applied_hardforks"
+};
+
+constexpr size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+using connection_ptr = std::unique_ptr< PGconn, decltype( &PQfinish ) >;
+using result_ptr = std::unique_ptr< PGresult, decltype( &PQclear ) >;
+
+connection_ptr connect( const std::string& db_url )
+{
+  connection_ptr connection( PQconnectdb( db_url.c_str() ), &PQfinish );
+  FC_ASSERT( connection && PQstatus( connection.get() ) == CONNECTION_OK
+    , "Cannot connect to the database: ${e}", ( "e", connection ? PQerrorMessage( connection.get() ) : "out of memory" ) );
+  return connection;
+}
+
+result_ptr exec( PGconn* connection, const std::string& query )
+{
+  result_ptr result( PQexec( connection, query.c_str() ), &PQclear );
+  const auto status = result ? PQresultStatus( result.get() ) : PGRES_FATAL_ERROR;
+  if ( status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK && status != PGRES_COPY_IN )
+    FC_THROW( "Query `${q}' failed: ${e}", ( "q", query )( "e", PQerrorMessage( connection ) ) );
+  return result;
+}
+
+std::string escape_literal( PGconn* connection, const std::string& value )
+{
+  std::unique_ptr< char, decltype( &PQfreemem ) > escaped( PQescapeLiteral( connection, value.c_str(), value.size() ), &PQfreemem );
+  FC_ASSERT( escaped, "Cannot escape `${v}': ${e}", ( "v", value )( "e", PQerrorMessage( connection ) ) );
+  return escaped.get();
+}
+
+bool is_loadable_table( const std::string& table )
+{
+  return std::any_of( LOAD_STAGES.begin(), LOAD_STAGES.end(), [&table]( const auto& stage ){ return stage.count( table ) != 0; } );
+}
+
+} // namespace
+
+manifest read_manifest( const std::string& manifest_path )
+{
+  std::ifstream input( manifest_path );
+  FC_ASSERT( input.is_open(), "Cannot open manifest file ${p}", ( "p", manifest_path ) );
+
+  const auto manifest_directory = std::filesystem::path( manifest_path ).parent_path();
+
+  manifest result;
+  std::set< std::tuple< std::string, uint32_t, uint32_t > > already_listed;
+  std::string line;
+  uint32_t line_number = 0;
+  while ( std::getline( input, line ) )
+  {
+    ++line_number;
+    const auto first_character = line.find_first_not_of( " \t\r" );
+    if ( first_character == std::string::npos || line[ first_character ] == '#' )
+      continue;
+
+    manifest_entry entry;
+    std::istringstream fields( line );
+    FC_ASSERT( fields >> entry.table >> entry.first_block >> entry.last_block >> entry.path
+      , "Malformed manifest line ${n}: `${l}'", ( "n", line_number )( "l", line ) );
+    FC_ASSERT( is_loadable_table( entry.table ), "Unknown table `${t}' in manifest line ${n}", ( "t", entry.table )( "n", line_number ) );
+    FC_ASSERT( entry.first_block <= entry.last_block, "Wrong blocks range in manifest line ${n}", ( "n", line_number ) );
+    FC_ASSERT( already_listed.emplace( entry.table, entry.first_block, entry.last_block ).second
+      , "Range [${f}, ${l}] of table ${t} is listed twice", ( "f", entry.first_block )( "l", entry.last_block )( "t", entry.table ) );
+
+    if ( std::filesystem::path( entry.path ).is_relative() )
+      entry.path = ( manifest_directory / entry.path ).string();
+    FC_ASSERT( std::filesystem::exists( entry.path ), "File ${p} from manifest line ${n} does not exist", ( "p", entry.path )( "n", line_number ) );
+
+    result.push_back( std::move( entry ) );
+  }
+
+  return result;
+}
+
+loader::loader( std::string db_url, uint32_t connections_number )
+  : _db_url( std::move( db_url ) )
+  , _connections_number( std::max( connections_number, 1u ) )
+{
+}
+
+void
+loader::load( const manifest& files ) {
+  std::vector< const manifest_entry* > blocks;
+  for ( const auto& file : files )
+    if ( file.table == "blocks" )
+      blocks.push_back( &file );
+
+  FC_ASSERT( !blocks.empty(), "Manifest does not contain any hive.blocks file, cannot determine the head of irreversible blocks" );
+  std::sort( blocks.begin(), blocks.end(), []( auto lhs, auto rhs ){ return lhs->first_block < rhs->first_block; } );
+  for ( auto it = std::next( blocks.begin() ); it != blocks.end(); ++it )
+    FC_ASSERT( (*it)->first_block == (*std::prev( it ))->last_block + 1
+      , "Blocks ranges in manifest are not contiguous: [${f1}, ${l1}] is followed by [${f2}, ${l2}]"
+      , ( "f1", (*std::prev( it ))->first_block )( "l1", (*std::prev( it ))->last_block )( "f2", (*it)->first_block )( "l2", (*it)->last_block ) );
+
+  prepare_database();
+
+  for ( const auto& stage : LOAD_STAGES )
+  {
+    std::vector< const manifest_entry* > stage_files;
+    for ( const auto& file : files )
+      if ( stage.count( file.table ) )
+        stage_files.push_back( &file );
+
+    load_stage( stage_files );
+  }
+
+  finish_massive_sync( blocks.back()->last_block );
+  restore_indexes_and_constraints();
+}
+
+void
+loader::prepare_database() {
+  auto connection = connect( _db_url );
+
+  // hive.bulk_loaded_files comes with the hive_fork_manager extension, it is checked before anything is dropped
+  const auto tables = exec( connection.get(), "SELECT to_regclass( 'hive.bulk_loaded_files' ) IS NOT NULL" );
+  FC_ASSERT( std::string( PQgetvalue( tables.get(), 0, 0 ) ) == "t", "hive_fork_manager extension in the database has no hive.bulk_loaded_files table, upgrade it" );
+
+  ilog( "Dropping foreign keys and indexes of irreversible tables..." );
+  exec( connection.get(), "SELECT hive.set_irreversible_dirty()" );
+  // both functions save definitions only once, so they are safe to be called again by a resumed load
+  exec( connection.get(), "SELECT hive.disable_fk_of_irreversible()" );
+  exec( connection.get(), "SELECT hive.disable_indexes_of_irreversible()" );
+  ilog( "All irreversible blocks tables foreign keys and indexes are dropped" );
+}
+
+void
+loader::load_stage( const std::vector< const manifest_entry* >& files ) {
+  if ( files.empty() )
+    return;
+
+  // the biggest files first, to not end the stage with a single connection busy
+  std::vector< std::pair< uintmax_t, const manifest_entry* > > queue;
+  for ( auto file : files )
+    queue.emplace_back( std::filesystem::file_size( file->path ), file );
+  std::sort( queue.begin(), queue.end(), []( const auto& lhs, const auto& rhs ){ return lhs.first > rhs.first; } );
+
+  std::atomic< size_t > next_file{ 0 };
+  std::atomic_bool failed{ false };
+  std::exception_ptr first_error;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    try
+    {
+      auto connection = connect( _db_url );
+      // durability of a single file does not matter, after a crash it is simply loaded again
+      exec( connection.get(), "SET synchronous_commit = OFF" );
+
+      for ( auto index = next_file++; index < queue.size() && !failed; index = next_file++ )
+        load_file( connection.get(), *queue[ index ].second );
+    }
+    catch ( ... )
+    {
+      std::lock_guard< std::mutex > lock( error_mutex );
+      if ( !first_error )
+        first_error = std::current_exception();
+      failed = true;
+    }
+  };
+
+  const auto threads_number = std::min< size_t >( _connections_number, queue.size() );
+  std::vector< std::thread > threads;
+  for ( size_t i = 0; i < threads_number; ++i )
+    threads.emplace_back( worker );
+  for ( auto& thread : threads )
+    thread.join();
+
+  if ( first_error )
+    std::rethrow_exception( first_error );
+}
+
+bool
+loader::load_file( PGconn* connection, const manifest_entry& file ) {
+  const auto start_time = fc::time_point::now();
+  const std::string range_condition =
+      "table_name = " + escape_literal( connection, file.table )
+    + " AND first_block = " + std::to_string( file.first_block )
+    + " AND last_block = " + std::to_string( file.last_block );
+
+  exec( connection, "BEGIN" );
+  if ( PQntuples( exec( connection, "SELECT 1 FROM hive.bulk_loaded_files WHERE " + range_condition ).get() ) != 0 )
+  {
+    exec( connection, "ROLLBACK" );
+    ilog( "hive.${t} [${f}, ${l}] was already loaded, skipping ${p}", ( "t", file.table )( "f", file.first_block )( "l", file.last_block )( "p", file.path ) );
+    return false;
+  }
+
+  std::unique_ptr< FILE, decltype( &fclose ) > input( fopen( file.path.c_str(), "rb" ), &fclose );
+  FC_ASSERT( input, "Cannot open ${p}", ( "p", file.path ) );
+
+  exec( connection, "COPY hive." + file.table + " FROM STDIN" );
+
+  std::vector< char > buffer( COPY_BUFFER_SIZE );
+  size_t read_bytes = 0;
+  while ( ( read_bytes = fread( buffer.data(), 1, buffer.size(), input.get() ) ) > 0 )
+    FC_ASSERT( PQputCopyData( connection, buffer.data(), read_bytes ) == 1, "COPY to hive.${t} failed: ${e}", ( "t", file.table )( "e", PQerrorMessage( connection ) ) );
+
+  const bool read_error = ferror( input.get() );
+  FC_ASSERT( PQputCopyEnd( connection, read_error ? "cannot read input file" : nullptr ) == 1
+    , "COPY to hive.${t} failed: ${e}", ( "t", file.table )( "e", PQerrorMessage( connection ) ) );
+
+  std::string rows;
+  bool copy_succeeded = true;
+  for ( result_ptr result( PQgetResult( connection ), &PQclear ); result; result.reset( PQgetResult( connection ) ) )
+  {
+    if ( PQresultStatus( result.get() ) == PGRES_COMMAND_OK )
+      rows = PQcmdTuples( result.get() );
+    else
+      copy_succeeded = false;
+  }
+  FC_ASSERT( copy_succeeded && !read_error, "Loading ${p} into hive.${t} failed: ${e}", ( "p", file.path )( "t", file.table )( "e", PQerrorMessage( connection ) ) );
+
+  exec( connection,
+      "INSERT INTO hive.bulk_loaded_files VALUES( "
+    + escape_literal( connection, file.table ) + ", "
+    + std::to_string( file.first_block ) + ", "
+    + std::to_string( file.last_block ) + ", "
+    + escape_literal( connection, file.path ) + ", "
+    + ( rows.empty() ? "0" : rows ) + ", LOCALTIMESTAMP )"
+  );
+  exec( connection, "COMMIT" );
+
+  ilog( "Loaded ${r} rows of hive.${t} [${f}, ${l}] in ${time} ms"
+    , ( "r", rows )( "t", file.table )( "f", file.first_block )( "l", file.last_block )( "time", ( fc::time_point::now() - start_time ).count() / 1000.0 ) );
+  return true;
+}
+
+void
+loader::finish_massive_sync( uint32_t last_block ) {
+  auto connection = connect( _db_url );
+  exec( connection.get(), "SELECT hive.end_massive_sync(" + std::to_string( last_block ) + ")" );
+  exec( connection.get(), "SELECT hive.set_irreversible_not_dirty()" );
+  ilog( "Massive sync finished at block ${b}", ( "b", last_block ) );
+}
+
+void
+loader::restore_indexes_and_constraints() {
+  const auto start_time = fc::time_point::now();
+
+  std::vector< std::string > queries;
+  for ( const auto& table : IRREVERSIBLE_TABLES )
+    queries.push_back( "SELECT hive.restore_indexes( 'hive." + table + "' )" );
+  execute_in_parallel( queries );
+  ilog( "All irreversible blocks tables indexes are re-created" );
+
+  // the same order as sql_serializer uses: hive.blocks is restored at the end
+  queries.clear();
+  for ( const auto& table : IRREVERSIBLE_TABLES )
+    if ( table != "blocks" )
+      queries.push_back( "SELECT hive.restore_foreign_keys( 'hive." + table + "' )" );
+  execute_in_parallel( queries );
+  execute_in_parallel( { "SELECT hive.restore_foreign_keys( 'hive.blocks' )" } );
+  ilog( "All irreversible blocks tables foreign keys are re-created in ${time} ms", ( "time", ( fc::time_point::now() - start_time ).count() / 1000.0 ) );
+}
+
+void
+loader::execute_in_parallel( const std::vector< std::string >& queries ) {
+  std::exception_ptr first_error;
+  std::mutex error_mutex;
+
+  std::vector< std::thread > threads;
+  for ( const auto& query : queries )
+    threads.emplace_back( [&, query]() {
+      try
+      {
+        auto connection = connect( _db_url );
+        exec( connection.get(), query );
+      }
+      catch ( ... )
+      {
+        std::lock_guard< std::mutex > lock( error_mutex );
+        if ( !first_error )
+          first_error = std::current_exception();
+      }
+    } );
+
+  for ( auto& thread : threads )
+    thread.join();
+
+  if ( first_error )
+    std::rethrow_exception( first_error );
+}
+
+} // namespace bulk_loader
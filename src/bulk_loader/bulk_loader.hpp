@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct pg_conn;
+
+namespace bulk_loader {
+
+/**
+ * One line of the manifest: a file in PostgreSQL COPY text format which holds rows
+ * of one irreversible table (hive.<table>) for blocks [first_block, last_block].
+ */
+struct manifest_entry
+{
+  std::string table;
+  uint32_t    first_block = 0;
+  uint32_t    last_block = 0;
+  std::string path;
+};
+
+using manifest = std::vector< manifest_entry >;
+
+/**
+ * Manifest is a text file, one entry per line: `<table> <first_block> <last_block> <path>`.
+ * Empty lines and lines starting with '#' are ignored, relative paths are resolved against
+ * the manifest directory.
+ */
+manifest read_manifest( const std::string& manifest_path );
+
+class loader
+{
+public:
+  loader( std::string db_url, uint32_t connections_number );
+
+  /// Loads all not yet loaded files from the manifest, then finishes massive sync and restores indexes
+  void load( const manifest& files );
+
+private:
+  void prepare_database();
+  void load_stage( const std::vector< const manifest_entry* >& files );
+  /// returns false when the file was already loaded by a previous run
+  bool load_file( pg_conn* connection, const manifest_entry& file );
+  void finish_massive_sync( uint32_t last_block );
+  void restore_indexes_and_constraints();
+  void execute_in_parallel( const std::vector< std::string >& queries );
+
+private:
+  const std::string _db_url;
+  const uint32_t    _connections_number;
+};
+
+} // namespace bulk_loader
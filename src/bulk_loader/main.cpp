@@ -0,0 +1,57 @@
+#include "bulk_loader.hpp"
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Loads files exported from sql_serializer into a HAF database" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "url,u", po::value< std::string >()->required(), "postgres connection string to the HAF database, e.g. `dbname=haf_block_log'" )
+    ( "manifest,m", po::value< std::string >()->required(), "manifest file, each line: <table> <first_block> <last_block> <path to COPY file>" )
+    ( "jobs,j", po::value< uint32_t >()->default_value( 8 ), "number of parallel connections used to load files" )
+    ;
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    const auto files = bulk_loader::read_manifest( args[ "manifest" ].as< std::string >() );
+    ilog( "Manifest contains ${n} files", ( "n", files.size() ) );
+
+    bulk_loader::loader loader( args[ "url" ].as< std::string >(), args[ "jobs" ].as< uint32_t >() );
+    loader.load( files );
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Bulk load failed: ${e}", ( "e", e.to_detail_string() ) );
+    return 1;
+  }
+  catch ( const std::exception& e )
+  {
+    elog( "Bulk load failed: ${e}", ( "e", e.what() ) );
+    return 1;
+  }
+
+  ilog( "Bulk load finished" );
+  return 0;
+}
@@ -116,6 +116,75 @@ END;
 $BODY$
 ;
 
+CREATE OR REPLACE FUNCTION hive.app_next_blocks( _context_name TEXT, _max_blocks INT )
+    RETURNS hive.blocks_range
+    LANGUAGE plpgsql
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __result hive.blocks_range;
+    __context_id hive.contexts.id%TYPE;
+    __events_id hive.events_queue.id%TYPE;
+    __current_block_num hive.contexts.current_block_num%TYPE;
+    __irreversible_block hive.contexts.irreversible_block%TYPE;
+    __last_event_id hive.events_queue.id%TYPE;
+    __last_block_num hive.blocks.num%TYPE;
+BEGIN
+    IF _max_blocks IS NULL OR _max_blocks < 1 THEN
+        RAISE EXCEPTION 'Maximum number of blocks has to be positive, but is %', _max_blocks;
+    END IF;
+
+    __result := hive.app_next_block( _context_name );
+
+    IF __result IS NULL OR __result.first_block != __result.last_block OR _max_blocks = 1 THEN
+        RETURN __result;
+    END IF;
+
+    SELECT hc.id, hc.events_id, hc.current_block_num, hc.irreversible_block
+    INTO __context_id, __events_id, __current_block_num, __irreversible_block
+    FROM hive.contexts hc WHERE hc.name = _context_name;
+
+    -- only a block of NEW_BLOCK event of a forking context may be followed by next blocks
+    IF __current_block_num <= __irreversible_block OR NOT hive.app_is_forking( _context_name ) THEN
+        RETURN __result;
+    END IF;
+
+    -- the longest run of NEW_BLOCK events for consecutive blocks, any other event ends the range
+    WITH next_events AS (
+        SELECT heq.id, heq.event, heq.block_num, ROW_NUMBER() OVER ( ORDER BY heq.id ) as position
+        FROM hive.events_queue heq
+        WHERE heq.id > __events_id
+        ORDER BY heq.id
+        LIMIT _max_blocks - 1
+    )
+    SELECT MAX( ne.id ), MAX( ne.block_num ) INTO __last_event_id, __last_block_num
+    FROM next_events ne
+    WHERE ne.position < COALESCE(
+        (
+            SELECT MIN( ne2.position )
+            FROM next_events ne2
+            WHERE ne2.event != 'NEW_BLOCK' OR ne2.block_num != __result.last_block + ne2.position
+        )
+        , _max_blocks
+    );
+
+    IF __last_event_id IS NULL THEN
+        RETURN __result;
+    END IF;
+
+    UPDATE hive.contexts
+    SET   events_id = __last_event_id
+        , current_block_num = __last_block_num
+        , bulk_ranges = array_append( bulk_ranges, int4range( __result.first_block, __last_block_num, '[]' ) )
+    WHERE id = __context_id;
+
+    __result.last_block = __last_block_num;
+    RETURN __result;
+END;
+$BODY$
+;
+
 CREATE OR REPLACE FUNCTION hive.app_context_attach( _context TEXT, _last_synced_block INT )
     RETURNS void
     LANGUAGE 'plpgsql'
@@ -454,3 +523,85 @@ END
 $BODY$
 LANGUAGE plpgsql VOLATILE; 
 
+
+DROP FUNCTION IF EXISTS hive.app_has_next_event( _context hive.context_name );
+--- Returns true when hive.app_next_block has something to process for the context: irreversible blocks
+--- or events not processed yet. It uses the same predicate as hive.find_next_event, but does not change the context.
+CREATE FUNCTION hive.app_has_next_event( _context hive.context_name )
+RETURNS BOOLEAN
+AS
+$BODY$
+DECLARE
+  __context_id hive.contexts.id%TYPE;
+  __events_id hive.events_queue.id%TYPE;
+  __current_block_num hive.blocks.num%TYPE;
+  __irreversible_block hive.blocks.num%TYPE;
+  __newest_irreversible_block_num hive.blocks.num%TYPE;
+BEGIN
+  SELECT hc.id, hc.events_id, hc.current_block_num, hc.irreversible_block
+  INTO __context_id, __events_id, __current_block_num, __irreversible_block
+  FROM hive.contexts hc WHERE hc.name = _context;
+
+  IF __context_id IS NULL THEN
+    RAISE EXCEPTION 'No context with name %', _context;
+  END IF;
+
+  SELECT hid.consistent_block INTO __newest_irreversible_block_num FROM hive.irreversible_data hid;
+
+  IF __current_block_num <= __irreversible_block AND __newest_irreversible_block_num IS NOT NULL THEN
+    -- context processes irreversible blocks, hive.find_next_event does not use events_id here
+    IF __current_block_num < __newest_irreversible_block_num THEN
+      RETURN TRUE;
+    END IF;
+
+    IF EXISTS(
+      SELECT NULL FROM hive.events_queue heq
+      WHERE heq.block_num > __irreversible_block AND ( heq.event = 'NEW_IRREVERSIBLE' OR heq.event = 'MASSIVE_SYNC' )
+    ) THEN
+      RETURN TRUE;
+    END IF;
+
+    -- a non-forking context processes only irreversible blocks, so it has to wait for a new irreversible block
+    IF NOT hive.app_is_forking( _context ) THEN
+      RETURN FALSE;
+    END IF;
+
+    -- a forking context continues with the first reversible block
+    RETURN EXISTS(
+      SELECT NULL FROM hive.events_queue heq
+      WHERE heq.block_num > __newest_irreversible_block_num AND heq.event != 'BACK_FROM_FORK'
+    );
+  END IF;
+
+  RETURN EXISTS( SELECT NULL FROM hive.events_queue heq WHERE heq.id > __events_id );
+END
+$BODY$
+LANGUAGE plpgsql STABLE;
+
+DROP FUNCTION IF EXISTS hive.wait_for_next_event( _context hive.context_name, _timeout INTERVAL );
+--- Waits (until specified _timeout) until hive.app_next_block has something to process for the context.
+--- Returns true as soon as there is a new event or irreversible block, false on _timeout.
+--- hived sends a notification on the 'hive_events' channel with each new event, so an application which can LISTEN
+--- should rather wait for notifications and call this function with zero _timeout only to not miss events added before LISTEN.
+CREATE FUNCTION hive.wait_for_next_event( _context hive.context_name, _timeout INTERVAL DEFAULT '0'::INTERVAL )
+RETURNS BOOLEAN
+AS
+$BODY$
+DECLARE
+  __wait_time INTERVAL := '100 ms'::interval;
+  __start TIMESTAMPTZ := CLOCK_TIMESTAMP();
+BEGIN
+  LOOP
+    IF hive.app_has_next_event( _context ) THEN
+      RETURN TRUE;
+    END IF;
+
+    EXIT WHEN CLOCK_TIMESTAMP() - __start >= _timeout;
+
+    PERFORM pg_sleep_for( LEAST( __wait_time, _timeout - ( CLOCK_TIMESTAMP() - __start ) ) );
+  END LOOP;
+
+  RETURN FALSE;
+END
+$BODY$
+LANGUAGE plpgsql VOLATILE;
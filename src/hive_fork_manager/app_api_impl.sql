@@ -9,6 +9,7 @@ DECLARE
     __newest_irreversible_block_num hive.blocks.num%TYPE;
     __current_context_block_num hive.blocks.num%TYPE;
     __current_context_irreversible_block hive.blocks.num%TYPE;
+    __state hive.events_queue_state%ROWTYPE;
     __result hive.events_queue%ROWTYPE;
 BEGIN
     SELECT hc.events_id
@@ -20,27 +21,42 @@ BEGIN
     IF __current_context_block_num <= __current_context_irreversible_block  AND  __newest_irreversible_block_num IS NOT NULL THEN
         -- here we are sure that context only processing irreversible blocks, we can continue
         -- processing irreversible blocks or find next event after irreversible
-        SELECT * INTO  __result
-        FROM hive.events_queue heq
-        WHERE heq.block_num > __newest_irreversible_block_num
-              AND heq.event != 'BACK_FROM_FORK'
-        ORDER BY heq.id LIMIT 1;
+        SELECT * INTO __state FROM hive.events_queue_state;
+
+        IF __state.irreversible_block = __newest_irreversible_block_num THEN
+            -- hived has already found both events for the newest irreversible block
+            SELECT * INTO __result
+            FROM hive.events_queue heq
+            WHERE heq.id = __state.first_reversible_event_id;
 
-        IF __result IS NULL THEN
-            -- there is no reversible blocks event
-            -- the last possible event are MASSIVE_SYNC(__newest_irreversible_block_num) or NEW_IRREVERSIBLE(__newest_irreversible_block_num)
+            IF __result IS NULL THEN
+                SELECT * INTO __result
+                FROM hive.events_queue heq
+                WHERE heq.id = __state.irreversible_event_id;
+            END IF;
+        ELSE
             SELECT * INTO  __result
             FROM hive.events_queue heq
-            WHERE heq.block_num = __newest_irreversible_block_num
-              AND ( heq.event = 'MASSIVE_SYNC' OR heq.event = 'NEW_IRREVERSIBLE' )
+            WHERE heq.block_num > __newest_irreversible_block_num
+                  AND heq.event != 'BACK_FROM_FORK'
             ORDER BY heq.id LIMIT 1;
 
-            IF __result IS NOT NULL AND __result.id = __curent_events_id THEN
-                -- when there is no event than recently processed
-                RETURN NULL;
+            IF __result IS NULL THEN
+                -- there is no reversible blocks event
+                -- the last possible event are MASSIVE_SYNC(__newest_irreversible_block_num) or NEW_IRREVERSIBLE(__newest_irreversible_block_num)
+                SELECT * INTO  __result
+                FROM hive.events_queue heq
+                WHERE heq.block_num = __newest_irreversible_block_num
+                  AND ( heq.event = 'MASSIVE_SYNC' OR heq.event = 'NEW_IRREVERSIBLE' )
+                ORDER BY heq.id LIMIT 1;
             END IF;
         END IF;
 
+        IF __result IS NOT NULL AND __result.block_num <= __newest_irreversible_block_num AND __result.id = __curent_events_id THEN
+            -- when there is no event than recently processed
+            RETURN NULL;
+        END IF;
+
         UPDATE hive.contexts
         SET irreversible_block = __newest_irreversible_block_num WHERE name = _context;
     ELSE
@@ -165,6 +181,8 @@ AS
 $BODY$
 DECLARE
     __current_event_id hive.events_queue.id%TYPE;
+    __last_fork_event_id BIGINT;
+    __last_massive_sync_event_id BIGINT;
 BEGIN
     SELECT hc.events_id INTO __current_event_id FROM hive.contexts hc WHERE hc.name = _context;
 
@@ -173,7 +191,18 @@ BEGIN
             RETURN;
     END IF;
 
-    IF NOT hive.squash_end_massive_sync_events( _context ) THEN
+    -- hived keeps ids of the newest fork and massive sync, the queue is searched only when there are newer ones
+    SELECT heqs.last_fork_event_id, heqs.last_massive_sync_event_id
+    INTO __last_fork_event_id, __last_massive_sync_event_id
+    FROM hive.events_queue_state heqs;
+
+    IF __last_massive_sync_event_id > COALESCE( __current_event_id, 1 ) THEN
+        IF hive.squash_end_massive_sync_events( _context ) THEN
+            RETURN;
+        END IF;
+    END IF;
+
+    IF __last_fork_event_id > __current_event_id THEN
         PERFORM hive.squash_fork_events( _context );
     END IF;
 END;
@@ -237,14 +266,30 @@ BEGIN
         FROM hive.fork hf
         WHERE hf.id = __next_event_block_num; -- block_num for BFF events = fork_id
 
-        PERFORM hive.context_back_from_fork( _context_name, __next_event_block_num );
+        -- changes made during a range returned by hive.app_next_blocks are saved with its last block,
+        -- when the fork is inside the range, then whole range is reverted
+        SELECT MIN( lower( br ) ) INTO __next_block_to_process
+        FROM hive.contexts hc, unnest( hc.bulk_ranges ) br
+        WHERE hc.id = __context_id AND lower( br ) <= __next_event_block_num AND upper( br ) - 1 > __next_event_block_num;
+
+        PERFORM hive.context_back_from_fork( _context_name, LEAST( __next_event_block_num, __next_block_to_process - 1 ) );
 
         UPDATE hive.contexts
         SET
             current_block_num = __next_event_block_num
           , fork_id = __fork_id
+          , bulk_ranges = CASE WHEN __next_block_to_process IS NULL THEN bulk_ranges
+                          ELSE array_append( bulk_ranges, int4range( __next_block_to_process, __next_event_block_num, '[]' ) ) END
         WHERE id = __context_id;
-        RETURN NULL;
+
+        IF __next_block_to_process IS NULL THEN
+            RETURN NULL;
+        END IF;
+
+        -- blocks of the reverted range which stay in the new fork have to be processed again
+        __result.first_block = __next_block_to_process;
+        __result.last_block = __next_event_block_num;
+        RETURN __result;
     WHEN 'NEW_IRREVERSIBLE' THEN
         -- we may got on context  creation irreversible block based on hive.irreversible_data
         -- unfortunetly some slow app may prevent to removing this event, so wee need to process it
@@ -290,7 +335,7 @@ BEGIN
 
     IF __next_block_to_process IS NULL THEN
             -- There is no new and expected block, needs to wait for a new block
-            PERFORM pg_sleep( 1.5 );
+            PERFORM hive.wait_for_next_event( _context_name, '1.5 s'::INTERVAL );
             RETURN NULL;
     END IF;
 
@@ -375,7 +420,7 @@ BEGIN
 
     IF __next_block_to_process IS NULL THEN
         -- There is no new and expected block, needs to wait for a new block
-        PERFORM pg_sleep( 1.5 );
+        PERFORM hive.wait_for_next_event( _context_name, '1.5 s'::INTERVAL );
         RETURN NULL;
     END IF;
 
@@ -416,9 +461,17 @@ BEGIN
     --so as to remove redundant records from `irreversible` tables,
     --because it's no need to hold the same records in both types of tables `reversible`/`irreversible`,
     --(every context retrieves records using a view, that finally returns data from both types of tables using UNION ALL operator).
-    UPDATE hive.contexts
+    --Contexts locked by applications are skipped, so hived never waits for them,
+    --they get the new irreversible block in hive.find_next_event.
+    UPDATE hive.contexts hc
     SET irreversible_block = _new_irreversible_block
-    WHERE current_block_num <= irreversible_block AND _new_irreversible_block > irreversible_block;
+    FROM (
+        SELECT hcl.id
+        FROM hive.contexts hcl
+        WHERE hcl.current_block_num <= hcl.irreversible_block AND _new_irreversible_block > hcl.irreversible_block
+        FOR UPDATE SKIP LOCKED
+    ) as unlocked
+    WHERE hc.id = unlocked.id;
 END;
 $BODY$
 ;
@@ -68,6 +68,7 @@ GRANT EXECUTE ON FUNCTION
     , hive.push_block( hive.blocks, hive.transactions[], hive.transactions_multisig[], hive.operations[], hive.accounts[], hive.account_operations[], hive.applied_hardforks[] )
     , hive.set_irreversible( INT )
     , hive.end_massive_sync( INTEGER )
+    , hive.notify_event( hive.event_type, BIGINT )
     , hive.disable_indexes_of_irreversible()
     , hive.enable_indexes_of_irreversible()
     , hive.save_and_drop_indexes_constraints( in _schema TEXT, in _table TEXT )
@@ -99,6 +100,7 @@ GRANT EXECUTE ON FUNCTION
     , hive.enable_fk_of_irreversible()
     , hive.save_and_drop_constraints( in _table_schema TEXT, in _table_name TEXT )
     , hive.refresh_irreversible_block_for_all_contexts( _new_irreversible_block INT )
+    , hive.refresh_events_queue_state( _irreversible_block INT )
     , hive.get_block_header( _block_num INT )
     , hive.get_block( _block_num INT )
     , hive.get_block_range( _starting_block_num INT, _count INT )
@@ -140,5 +142,6 @@ REVOKE EXECUTE ON FUNCTION
     , hive.remove_obsolete_reversible_data( _new_irreversible_block INT )
     , hive.remove_unecessary_events( _new_irreversible_block INT )
     , hive.refresh_irreversible_block_for_all_contexts( _new_irreversible_block INT )
+    , hive.refresh_events_queue_state( _irreversible_block INT )
 FROM hive_applications_group;
 
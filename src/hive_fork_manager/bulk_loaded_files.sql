@@ -0,0 +1,11 @@
+-- files loaded by haf_bulk_loader, a file is loaded in the same transaction which inserts its row,
+-- so after an interruption the table tells exactly which files have to be loaded again
+CREATE TABLE IF NOT EXISTS hive.bulk_loaded_files(
+    table_name TEXT NOT NULL,
+    first_block INTEGER NOT NULL,
+    last_block INTEGER NOT NULL,
+    file_path TEXT NOT NULL,
+    rows BIGINT NOT NULL,
+    loaded_at TIMESTAMP WITHOUT TIME ZONE NOT NULL,
+    CONSTRAINT pk_hive_bulk_loaded_files PRIMARY KEY( table_name, first_block, last_block )
+);
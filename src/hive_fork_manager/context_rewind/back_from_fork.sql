@@ -66,7 +66,7 @@ END;
 $BODY$
 ;
 
-CREATE OR REPLACE FUNCTION hive.back_from_fork_one_table( _table_schema TEXT, _table_name TEXT, _shadow_table_name TEXT, _block_num_before_fork INT )
+CREATE OR REPLACE FUNCTION hive.back_from_fork_one_table_row_by_row( _table_schema TEXT, _table_name TEXT, _shadow_table_name TEXT, _block_num_before_fork INT )
     RETURNS void
     LANGUAGE plpgsql
     VOLATILE
@@ -89,10 +89,92 @@ BEGIN
         , _shadow_table_name
         , _block_num_before_fork
     );
+END;
+$BODY$
+;
+
+-- Reverting all changes of a row in the reverse order leaves the row as it was stored by its earliest change after the fork:
+-- INSERT means the row did not exist before the fork, DELETE and UPDATE store the row from before the change.
+-- So the whole table is reverted with three statements, each using only the earliest change of every row.
+CREATE OR REPLACE FUNCTION hive.back_from_fork_one_table_set_based( _table_schema TEXT, _table_name TEXT, _shadow_table_name TEXT, _block_num_before_fork INT )
+    RETURNS void
+    LANGUAGE plpgsql
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __columns_names TEXT[];
+    __columns TEXT;
+    __shadow_columns TEXT;
+    __earliest_changes TEXT;
+BEGIN
+    SELECT hrt.origin_table_columns INTO __columns_names
+    FROM hive.registered_tables hrt
+    WHERE hrt.shadow_table_name = _shadow_table_name;
+
+    __columns = array_to_string( __columns_names, ',' );
+    __shadow_columns = array_to_string( ARRAY( SELECT 'st.' || c FROM unnest( __columns_names ) c ), ',' );
+    __earliest_changes = format(
+        'SELECT DISTINCT ON ( sh.hive_rowid ) sh.*
+        FROM hive.%I sh
+        WHERE sh.hive_block_num > %s
+        ORDER BY sh.hive_rowid, sh.hive_operation_id'
+        , _shadow_table_name
+        , _block_num_before_fork
+    );
+
+    -- rows inserted after the fork
+    EXECUTE format(
+        'DELETE FROM %I.%I t
+        USING ( %s ) st
+        WHERE t.hive_rowid = st.hive_rowid AND st.hive_operation_type = ''INSERT'''
+        , _table_schema, _table_name
+        , __earliest_changes
+    );
+
+    -- rows which still exist get their values back, so rows referencing them are untouched
+    EXECUTE format(
+        'UPDATE %I.%I t SET ( %s ) = ROW( %s )
+        FROM ( %s ) st
+        WHERE t.hive_rowid = st.hive_rowid AND st.hive_operation_type <> ''INSERT'''
+        , _table_schema, _table_name
+        , __columns, __shadow_columns
+        , __earliest_changes
+    );
+
+    -- rows removed after the fork
+    EXECUTE format(
+        'INSERT INTO %I.%I( %s )
+        SELECT %s
+        FROM ( %s ) st
+        WHERE st.hive_operation_type <> ''INSERT''
+        AND NOT EXISTS ( SELECT 1 FROM %I.%I t WHERE t.hive_rowid = st.hive_rowid )'
+        , _table_schema, _table_name, __columns
+        , __shadow_columns
+        , __earliest_changes
+        , _table_schema, _table_name
+    );
+END;
+$BODY$
+;
+
+CREATE OR REPLACE FUNCTION hive.back_from_fork_one_table( _table_schema TEXT, _table_name TEXT, _shadow_table_name TEXT, _block_num_before_fork INT )
+    RETURNS void
+    LANGUAGE plpgsql
+    VOLATILE
+AS
+$BODY$
+BEGIN
+    BEGIN
+        PERFORM hive.back_from_fork_one_table_set_based( _table_schema, _table_name, _shadow_table_name, _block_num_before_fork );
+    EXCEPTION WHEN unique_violation THEN
+        -- not deferrable unique constraints are checked for each row of a statement, so values swapped between rows
+        -- can be restored only by reverting changes one by one in the reverse order
+        PERFORM hive.back_from_fork_one_table_row_by_row( _table_schema, _table_name, _shadow_table_name, _block_num_before_fork );
+    END;
 
     -- remove rows from shadow table
     EXECUTE format( 'DELETE FROM hive.%I st WHERE st.hive_block_num > %s', _shadow_table_name, _block_num_before_fork );
 END;
 $BODY$
 ;
-
@@ -18,6 +18,9 @@ CREATE TABLE IF NOT EXISTS hive.contexts(
     owner NAME NOT NULL,
     detached_block_num INTEGER, -- place where application can save last processed block num in detached state
     registering_state_provider BOOL NOT NULL DEFAULT FALSE,
+    -- reversible blocks returned together by hive.app_next_blocks, changes of registered tables made during such a range
+    -- are saved with its last block, so a fork inside the range has to revert the whole range
+    bulk_ranges INT4RANGE[] NOT NULL DEFAULT '{}',
     CONSTRAINT pk_hive_contexts PRIMARY KEY( id ),
     CONSTRAINT uq_hive_context_name UNIQUE ( name )
 );
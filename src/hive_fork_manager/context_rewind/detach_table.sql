@@ -19,11 +19,11 @@ BEGIN
         RAISE EXCEPTION 'Table is not registered';
     END IF;
 
-    -- remove triggers functions
+    -- remove triggers functions, only tables registered by older versions have their own trigger functions
     FOR  __trigger_funtion_name IN SELECT ht.function_name FROM hive.triggers ht
-    WHERE ht.registered_table_id = __table_id
+    WHERE ht.registered_table_id = __table_id AND ht.function_name <> 'hive.on_registered_table_change'
     LOOP
-       EXECUTE format( 'DROP FUNCTION %s', __trigger_funtion_name );
+       EXECUTE format( 'DROP FUNCTION IF EXISTS %s', __trigger_funtion_name );
     END LOOP;
 
     -- remove informations about triggers
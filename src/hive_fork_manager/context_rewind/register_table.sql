@@ -142,10 +142,6 @@ DECLARE
     __hive_delete_trigger_name TEXT := hive.get_trigger_delete_name( _table_schema,  _table_name );
     __hive_update_trigger_name TEXT := hive.get_trigger_update_name( _table_schema,  _table_name );
     __hive_truncate_trigger_name TEXT := hive.get_trigger_truncate_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_insert TEXT := hive.get_trigger_insert_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_delete TEXT := hive.get_trigger_delete_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_update TEXT := hive.get_trigger_update_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_truncate TEXT := hive.get_trigger_truncate_function_name( _table_schema,  _table_name );
     __new_sequence_name TEXT := 'seq_' || lower(_table_schema) || '_' || lower(_table_name);
     __context_id INTEGER := NULL;
     __registered_table_id INTEGER := NULL;
@@ -184,136 +180,6 @@ BEGIN
     ASSERT __context_id IS NOT NULL, 'There is no context %', _context_name;
     ASSERT __registered_table_id IS NOT NULL;
 
-    -- create trigger functions
-    EXECUTE format(
-        'CREATE OR REPLACE FUNCTION %s()
-            RETURNS trigger
-            LANGUAGE plpgsql
-        AS
-        $$
-        DECLARE
-           __block_num INTEGER := NULL;
-           __values TEXT;
-           __is_back_from_fork_in_progress BOOL := FALSE;
-        BEGIN
-            SELECT back_from_fork FROM hive.contexts WHERE id=%s INTO __is_back_from_fork_in_progress;
-
-            IF ( __is_back_from_fork_in_progress = TRUE ) THEN
-                RETURN NEW;
-            END IF;
-            SELECT hc.current_block_num FROM hive.contexts hc WHERE hc.id = CAST( TG_ARGV[ 0 ] as INTEGER ) INTO __block_num;
-
-            IF ( __block_num <= 0 ) THEN
-                 RAISE EXCEPTION ''Did not execute hive.context_next_block before table edition'';
-            END IF;
-
-            INSERT INTO hive.%I SELECT n.*,  __block_num, ''INSERT'' FROM new_table n ON CONFLICT DO NOTHING;
-            RETURN NEW;
-        END;
-        $$'
-        , __hive_triggerfunction_name_insert
-        , __context_id
-        , __shadow_table_name
-    );
-
-    EXECUTE format(
-        'CREATE OR REPLACE FUNCTION %s()
-            RETURNS trigger
-            LANGUAGE plpgsql
-        AS
-        $$
-        DECLARE
-           __block_num INTEGER := NULL;
-           __values TEXT;
-           __is_back_from_fork_in_progress BOOL := FALSE;
-        BEGIN
-            SELECT back_from_fork FROM hive.contexts WHERE id=%s INTO __is_back_from_fork_in_progress;
-
-            IF ( __is_back_from_fork_in_progress = TRUE ) THEN
-                RETURN NEW;
-            END IF;
-
-            SELECT hc.current_block_num FROM hive.contexts hc WHERE hc.id = CAST( TG_ARGV[ 0 ] as INTEGER ) INTO __block_num;
-
-            IF ( __block_num <= 0 ) THEN
-                RAISE EXCEPTION ''Did not execute hive.context_next_block before table edition'';
-            END IF;
-
-            INSERT INTO hive.%I SELECT o.*, __block_num, ''DELETE'' FROM old_table o ON CONFLICT DO NOTHING;
-            RETURN NEW;
-        END;
-        $$'
-        , __hive_triggerfunction_name_delete
-        , __context_id
-        , __shadow_table_name
-    );
-
-    EXECUTE format(
-        'CREATE OR REPLACE FUNCTION %s()
-            RETURNS trigger
-            LANGUAGE plpgsql
-        AS
-        $$
-        DECLARE
-           __block_num INTEGER := NULL;
-           __values TEXT;
-           __is_back_from_fork_in_progress BOOL := FALSE;
-        BEGIN
-            SELECT back_from_fork FROM hive.contexts WHERE id=%s INTO __is_back_from_fork_in_progress;
-
-            IF ( __is_back_from_fork_in_progress = TRUE ) THEN
-                RETURN NEW;
-            END IF;
-
-            SELECT hc.current_block_num FROM hive.contexts hc WHERE hc.id = CAST( TG_ARGV[ 0 ] as INTEGER ) INTO __block_num;
-
-            IF ( __block_num <= 0 ) THEN
-                RAISE EXCEPTION ''Did not execute hive.context_next_block before table edition'';
-            END IF;
-
-            INSERT INTO hive.%I SELECT o.*, __block_num, ''UPDATE'' FROM old_table o ON CONFLICT DO NOTHING;
-            RETURN NEW;
-        END;
-        $$'
-        , __hive_triggerfunction_name_update
-        , __context_id
-        , __shadow_table_name
-    );
-
-    EXECUTE format(
-         'CREATE OR REPLACE FUNCTION %s()
-             RETURNS trigger
-             LANGUAGE plpgsql
-         AS
-         $$
-         DECLARE
-            __block_num INTEGER := NULL;
-            __values TEXT;
-            __is_back_from_fork_in_progress BOOL := FALSE;
-         BEGIN
-             SELECT back_from_fork FROM hive.contexts WHERE id=%s INTO __is_back_from_fork_in_progress;
-
-             IF ( __is_back_from_fork_in_progress = TRUE ) THEN
-                 RETURN NEW;
-             END IF;
-
-             SELECT hc.current_block_num FROM hive.contexts hc WHERE hc.id = CAST( TG_ARGV[ 0 ] as INTEGER ) INTO __block_num;
-
-             IF ( __block_num <= 0 ) THEN
-                 RAISE EXCEPTION ''Did not execute hive.context_next_block before table edition'';
-             END IF;
-
-             INSERT INTO hive.%I SELECT o.*, __block_num, ''DELETE'' FROM %I.%I o ON CONFLICT DO NOTHING;
-             RETURN NEW;
-         END;
-         $$'
-        , __hive_triggerfunction_name_truncate
-        , __context_id
-        , __shadow_table_name
-        , _table_schema
-        , _table_name
-    );
-
     PERFORM hive.create_triggers(  _table_schema, _table_name, __context_id );
 
     PERFORM hive.create_revert_functions( _table_schema, _table_name, __shadow_table_name, __columns_names );
@@ -321,10 +187,10 @@ BEGIN
     -- save information about the triggers
     INSERT INTO hive.triggers( registered_table_id, trigger_name, function_name, owner )
     VALUES
-         ( __registered_table_id, __hive_insert_trigger_name, __hive_triggerfunction_name_insert, current_user )
-       , ( __registered_table_id, __hive_delete_trigger_name, __hive_triggerfunction_name_delete, current_user )
-       , ( __registered_table_id, __hive_update_trigger_name, __hive_triggerfunction_name_update, current_user )
-       , ( __registered_table_id, __hive_truncate_trigger_name, __hive_triggerfunction_name_truncate, current_user )
+         ( __registered_table_id, __hive_insert_trigger_name, 'hive.on_registered_table_change', current_user )
+       , ( __registered_table_id, __hive_delete_trigger_name, 'hive.on_registered_table_change', current_user )
+       , ( __registered_table_id, __hive_update_trigger_name, 'hive.on_registered_table_change', current_user )
+       , ( __registered_table_id, __hive_truncate_trigger_name, 'hive.on_registered_table_change', current_user )
     ;
 END;
 $BODY$
@@ -370,11 +236,17 @@ BEGIN
     -- remove entry about the regitered table
     DELETE FROM hive.registered_tables as hrt  WHERE hrt.origin_table_schema = lower( _table_schema ) AND hrt.origin_table_name = lower( _table_name );
 
-    -- drop functions and triggers
-    EXECUTE format( 'DROP FUNCTION %s CASCADE', __hive_triggerfunction_name_insert );
-    EXECUTE format( 'DROP FUNCTION %s CASCADE', __hive_triggerfunction_name_delete );
-    EXECUTE format( 'DROP FUNCTION %s CASCADE', __hive_triggerfunction_name_update );
-    EXECUTE format( 'DROP FUNCTION %s CASCADE', __hive_triggerfunction_name_truncate );
+    -- drop triggers, they do not exist when the table is detached
+    EXECUTE format( 'DROP TRIGGER IF EXISTS %I ON %I.%I', __hive_insert_trigger_name, lower(_table_schema), lower(_table_name) );
+    EXECUTE format( 'DROP TRIGGER IF EXISTS %I ON %I.%I', __hive_delete_trigger_name, lower(_table_schema), lower(_table_name) );
+    EXECUTE format( 'DROP TRIGGER IF EXISTS %I ON %I.%I', __hive_update_trigger_name, lower(_table_schema), lower(_table_name) );
+    EXECUTE format( 'DROP TRIGGER IF EXISTS %I ON %I.%I', __hive_truncate_trigger_name, lower(_table_schema), lower(_table_name) );
+
+    -- tables registered by older versions have their own plpgsql trigger functions
+    EXECUTE format( 'DROP FUNCTION IF EXISTS %s CASCADE', __hive_triggerfunction_name_insert );
+    EXECUTE format( 'DROP FUNCTION IF EXISTS %s CASCADE', __hive_triggerfunction_name_delete );
+    EXECUTE format( 'DROP FUNCTION IF EXISTS %s CASCADE', __hive_triggerfunction_name_update );
+    EXECUTE format( 'DROP FUNCTION IF EXISTS %s CASCADE', __hive_triggerfunction_name_truncate );
 
     -- drop revert functions
     PERFORM hive.drop_revert_functions( _table_schema, _table_name );
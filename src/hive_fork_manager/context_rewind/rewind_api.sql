@@ -101,6 +101,7 @@ BEGIN
     UPDATE hive.contexts
     SET   current_block_num = _block_num_before_fork
         , back_from_fork = FALSE
+        , bulk_ranges = ARRAY( SELECT br FROM unnest( bulk_ranges ) br WHERE upper( br ) - 1 <= _block_num_before_fork )
     WHERE name = _context AND current_block_num > _block_num_before_fork;
 END;
 $BODY$
@@ -136,6 +137,7 @@ BEGIN
     UPDATE hive.contexts
     SET is_attached = FALSE,
         detached_block_num = NULL,
+        bulk_ranges = '{}',
         current_block_num = CASE WHEN current_block_num = 0 THEN 0 ELSE current_block_num - 1 END
     WHERE id = __context_id;
 END;
@@ -195,7 +197,10 @@ BEGIN
             RAISE EXCEPTION 'The proposed block number of irreversible block is lower than the current one for context %', _context;
     END IF;
 
-    UPDATE hive.contexts  SET irreversible_block = _block_num WHERE name = _context;
+    UPDATE hive.contexts
+    SET   irreversible_block = _block_num
+        , bulk_ranges = ARRAY( SELECT br FROM unnest( bulk_ranges ) br WHERE upper( br ) - 1 > _block_num )
+    WHERE name = _context;
 
     PERFORM
     hive.remove_obsolete_operations( hrt.shadow_table_name, _block_num )
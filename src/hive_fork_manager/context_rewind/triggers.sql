@@ -1,3 +1,20 @@
+-- all registered tables use the same trigger function, arguments of a trigger are the context id and the name of the shadow table
+CREATE OR REPLACE FUNCTION hive.on_registered_table_change()
+    RETURNS trigger
+    LANGUAGE C
+AS 'MODULE_PATHNAME', 'on_registered_table_change';
+
+-- the trigger function caches states of contexts in a transaction, each change of hive.contexts invalidates the cache
+CREATE OR REPLACE FUNCTION hive.on_contexts_change()
+    RETURNS trigger
+    LANGUAGE C
+AS 'MODULE_PATHNAME', 'on_contexts_change';
+
+DROP TRIGGER IF EXISTS hive_contexts_change_trigger ON hive.contexts;
+CREATE TRIGGER hive_contexts_change_trigger AFTER INSERT OR UPDATE OR DELETE ON hive.contexts FOR EACH STATEMENT EXECUTE PROCEDURE hive.on_contexts_change();
+-- the cache has to be invalidated even when triggers are switched off with session_replication_role
+ALTER TABLE hive.contexts ENABLE ALWAYS TRIGGER hive_contexts_change_trigger;
+
 CREATE OR REPLACE FUNCTION hive.create_triggers( _table_schema TEXT,  _table_name TEXT, _context_id hive.contexts.id%TYPE )
     RETURNS void
     LANGUAGE 'plpgsql'
@@ -10,54 +27,46 @@ DECLARE
     __hive_delete_trigger_name TEXT := hive.get_trigger_delete_name( _table_schema,  _table_name );
     __hive_update_trigger_name TEXT := hive.get_trigger_update_name( _table_schema,  _table_name );
     __hive_truncate_trigger_name TEXT := hive.get_trigger_truncate_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_insert TEXT := hive.get_trigger_insert_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_delete TEXT := hive.get_trigger_delete_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_update TEXT := hive.get_trigger_update_function_name( _table_schema,  _table_name );
-    __hive_triggerfunction_name_truncate TEXT := hive.get_trigger_truncate_function_name( _table_schema,  _table_name );
     __new_sequence_name TEXT := 'seq_' || lower(_table_schema) || '_' || lower(_table_name);
     __registered_table_id INTEGER := NULL;
     __columns_names TEXT[];
 BEGIN
     -- register insert trigger
     EXECUTE format(
-            'CREATE TRIGGER %I AFTER INSERT ON %s.%s REFERENCING NEW TABLE AS NEW_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE %s( %L, %L )'
+            'CREATE TRIGGER %I AFTER INSERT ON %s.%s REFERENCING NEW TABLE AS NEW_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE hive.on_registered_table_change( %L, %L )'
             , __hive_insert_trigger_name
             , _table_schema
             , _table_name
-            , __hive_triggerfunction_name_insert
             , _context_id
             , __shadow_table_name
     );
 
     -- register delete trigger
     EXECUTE format(
-            'CREATE TRIGGER %I AFTER DELETE ON %s.%s REFERENCING OLD TABLE AS OLD_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE %s( %L, %L )'
+            'CREATE TRIGGER %I AFTER DELETE ON %s.%s REFERENCING OLD TABLE AS OLD_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE hive.on_registered_table_change( %L, %L )'
             , __hive_delete_trigger_name
             , _table_schema
             , _table_name
-            , __hive_triggerfunction_name_delete
             , _context_id
             , __shadow_table_name
     );
 
     -- register update trigger
     EXECUTE format(
-            'CREATE TRIGGER %I AFTER UPDATE ON %s.%s REFERENCING OLD TABLE AS OLD_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE %s( %L, %L )'
+            'CREATE TRIGGER %I AFTER UPDATE ON %s.%s REFERENCING OLD TABLE AS OLD_TABLE FOR EACH STATEMENT EXECUTE PROCEDURE hive.on_registered_table_change( %L, %L )'
             , __hive_update_trigger_name
             , _table_schema
             , _table_name
-            , __hive_triggerfunction_name_update
             , _context_id
             , __shadow_table_name
     );
 
     -- register truncate trigger
     EXECUTE format(
-            'CREATE TRIGGER %I BEFORE TRUNCATE ON %s.%s FOR EACH STATEMENT EXECUTE PROCEDURE %s( %L, %L )'
+            'CREATE TRIGGER %I BEFORE TRUNCATE ON %s.%s FOR EACH STATEMENT EXECUTE PROCEDURE hive.on_registered_table_change( %L, %L )'
             , __hive_truncate_trigger_name
             , _table_schema
             , _table_name
-            , __hive_triggerfunction_name_truncate
             , _context_id
             , __shadow_table_name
     );
@@ -12,3 +12,23 @@ CREATE TABLE IF NOT EXISTS hive.events_queue(
 INSERT INTO hive.events_queue VALUES( 0, 'NEW_IRREVERSIBLE', 0 ) ON CONFLICT DO NOTHING;
 
 CREATE INDEX IF NOT EXISTS hive_events_queue_block_num_idx ON hive.events_queue( block_num );
+
+-- forks and massive syncs are rare, hive.squash_events and hive.refresh_events_queue_state look for them,
+-- so they scan only these events instead of the whole queue
+CREATE INDEX IF NOT EXISTS hive_events_queue_back_from_fork_idx ON hive.events_queue( id ) WHERE event = 'BACK_FROM_FORK';
+CREATE INDEX IF NOT EXISTS hive_events_queue_massive_sync_idx ON hive.events_queue( id ) WHERE event = 'MASSIVE_SYNC';
+
+-- State of the queue shared by all contexts. hived updates it once per event in hive.push_block, hive.back_from_fork,
+-- hive.set_irreversible and hive.end_massive_sync, applications only read it. The next event of a context is found
+-- with the context's events_id and this row, without searching the queue, and hived never waits for rows locked by applications.
+CREATE TABLE IF NOT EXISTS hive.events_queue_state(
+      id INTEGER NOT NULL
+    , irreversible_block INTEGER -- hive.irreversible_data.consistent_block for which the two ids below were found
+    , irreversible_event_id BIGINT -- the first NEW_IRREVERSIBLE or MASSIVE_SYNC of the irreversible_block
+    , first_reversible_event_id BIGINT -- the first event of a block above the irreversible_block, except BACK_FROM_FORK
+    , last_fork_event_id BIGINT NOT NULL -- the newest BACK_FROM_FORK, 0 when there is no one
+    , last_massive_sync_event_id BIGINT NOT NULL -- the newest MASSIVE_SYNC, 0 when there is no one
+    , CONSTRAINT pk_events_queue_state PRIMARY KEY( id )
+);
+
+INSERT INTO hive.events_queue_state VALUES( 1, NULL, NULL, NULL, 0, 0 ) ON CONFLICT DO NOTHING;
@@ -1,2 +1,9 @@
 CREATE OR REPLACE FUNCTION hive.get_impacted_accounts(IN hive.operation)
-RETURNS SETOF text AS 'MODULE_PATHNAME', 'get_impacted_accounts' LANGUAGE C;
+RETURNS SETOF text AS 'MODULE_PATHNAME', 'get_impacted_accounts' LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+-- Accounts impacted by all operations of blocks [_first_block, _last_block], the same as hive.get_impacted_accounts called for each of them.
+-- Operations are read in batches from _operations, which may be hive.operations or the operations view of a context.
+DROP FUNCTION IF EXISTS hive.get_impacted_accounts_in_range;
+CREATE OR REPLACE FUNCTION hive.get_impacted_accounts_in_range(IN _first_block INT, IN _last_block INT, IN _operations regclass = 'hive.operations')
+RETURNS TABLE( operation_id BIGINT, account_name TEXT )
+AS 'MODULE_PATHNAME', 'get_impacted_accounts_in_range' LANGUAGE C STABLE STRICT;
@@ -9,14 +9,15 @@ CREATE TYPE hive.impacted_balances_return AS
 
 CREATE OR REPLACE FUNCTION hive.get_impacted_balances(IN _operation_body hive.operation, IN _is_hf01 bool)
 RETURNS SETOF impacted_balances_return
-AS 'MODULE_PATHNAME', 'get_impacted_balances' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'get_impacted_balances' LANGUAGE C IMMUTABLE PARALLEL SAFE;
 
 --- Returns set of operations which impact account balances.
 
 CREATE OR REPLACE FUNCTION hive.get_impacted_balances(IN _operation_body hive.operation, IN _operation_block_number INT)
     RETURNS SETOF hive.impacted_balances_return
     LANGUAGE plpgsql
-    VOLATILE
+    STABLE
+    PARALLEL SAFE
 AS
 $BODY$
 DECLARE
@@ -39,4 +40,11 @@ CREATE TYPE hive.get_balance_impacting_operations_return_type AS
 DROP FUNCTION IF EXISTS hive.get_balance_impacting_operations;
 CREATE OR REPLACE FUNCTION hive.get_balance_impacting_operations()
 RETURNS SETOF hive.get_balance_impacting_operations_return_type
-AS 'MODULE_PATHNAME', 'get_balance_impacting_operations' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'get_balance_impacting_operations' LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+-- Balances impacted by all operations of blocks [_first_block, _last_block], the same as hive.get_impacted_balances( body, block_num ) called for each of them.
+-- Operations are read in batches from _operations, which may be hive.operations or the operations view of a context.
+DROP FUNCTION IF EXISTS hive.get_impacted_balances_in_range;
+CREATE OR REPLACE FUNCTION hive.get_impacted_balances_in_range(IN _first_block INT, IN _last_block INT, IN _operations regclass = 'hive.operations')
+RETURNS TABLE( operation_id BIGINT, account_name VARCHAR, amount BIGINT, asset_precision INT, asset_symbol_nai INT )
+AS 'MODULE_PATHNAME', 'get_impacted_balances_in_range' LANGUAGE C STABLE STRICT;
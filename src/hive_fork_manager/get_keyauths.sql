@@ -21,13 +21,14 @@ CREATE TYPE hive.keyauth_c_record_type AS
 DROP FUNCTION IF EXISTS hive.get_keyauths_wrapper;
 CREATE OR REPLACE FUNCTION hive.get_keyauths_wrapper(IN _operation_body hive.operation)
 RETURNS SETOF hive.keyauth_c_record_type
-AS 'MODULE_PATHNAME', 'get_keyauths_wrapped' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'get_keyauths_wrapped' LANGUAGE C IMMUTABLE PARALLEL SAFE;
 
 DROP FUNCTION IF EXISTS hive.authority_type_c_int_to_enum;
 CREATE OR REPLACE FUNCTION hive.authority_type_c_int_to_enum(IN _pos integer)
 RETURNS hive.authority_type
 LANGUAGE plpgsql
 IMMUTABLE
+PARALLEL SAFE
 AS
 $$
 DECLARE
@@ -42,6 +43,7 @@ CREATE OR REPLACE FUNCTION hive.get_keyauths(IN _operation_body hive.operation)
 RETURNS SETOF hive.keyauth_record_type
 LANGUAGE plpgsql
 IMMUTABLE
+PARALLEL SAFE
 AS
 $$
 BEGIN
@@ -63,9 +65,33 @@ CREATE TYPE hive.get_operations_type AS
 DROP FUNCTION IF EXISTS hive.get_keyauths_operations;
 CREATE OR REPLACE FUNCTION hive.get_keyauths_operations()
 RETURNS SETOF hive.get_operations_type
-AS 'MODULE_PATHNAME', 'get_keyauths_operations' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'get_keyauths_operations' LANGUAGE C IMMUTABLE PARALLEL SAFE;
 
 DROP FUNCTION IF EXISTS hive.is_keyauths_operation;
 CREATE OR REPLACE FUNCTION hive.is_keyauths_operation(IN _operation_body hive.operation)
 RETURNS Boolean
-AS 'MODULE_PATHNAME', 'is_keyauths_operation' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'is_keyauths_operation' LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+-- Keyauths of all operations of blocks [_first_block, _last_block], the same as hive.get_keyauths called for each of them.
+-- Operations are read in batches from _operations, which may be hive.operations or the operations view of a context.
+DROP FUNCTION IF EXISTS hive.get_keyauths_in_range_wrapper;
+CREATE OR REPLACE FUNCTION hive.get_keyauths_in_range_wrapper(IN _first_block INT, IN _last_block INT, IN _operations regclass)
+RETURNS TABLE( operation_id BIGINT, key_auth TEXT, authority_c_kind INTEGER, account_name TEXT )
+AS 'MODULE_PATHNAME', 'get_keyauths_in_range_wrapped' LANGUAGE C STABLE STRICT;
+
+DROP FUNCTION IF EXISTS hive.get_keyauths_in_range;
+CREATE OR REPLACE FUNCTION hive.get_keyauths_in_range(IN _first_block INT, IN _last_block INT, IN _operations regclass = 'hive.operations')
+RETURNS TABLE( operation_id BIGINT, key_auth TEXT, authority_kind hive.authority_type, account_name TEXT )
+LANGUAGE plpgsql
+STABLE
+AS
+$$
+BEGIN
+    RETURN QUERY SELECT
+        ka.operation_id,
+        ka.key_auth,
+        hive.authority_type_c_int_to_enum(ka.authority_c_kind),
+        ka.account_name
+        FROM hive.get_keyauths_in_range_wrapper(_first_block, _last_block, _operations) ka;
+END
+$$;
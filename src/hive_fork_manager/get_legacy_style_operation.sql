@@ -1,3 +1,3 @@
 CREATE OR REPLACE FUNCTION hive.get_legacy_style_operation(IN _operation_body hive.operation)
 RETURNS JSON
-AS 'MODULE_PATHNAME', 'get_legacy_style_operation' LANGUAGE C;
\ No newline at end of file
+AS 'MODULE_PATHNAME', 'get_legacy_style_operation' LANGUAGE C IMMUTABLE PARALLEL SAFE;
\ No newline at end of file
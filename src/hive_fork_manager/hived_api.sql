@@ -6,13 +6,18 @@ AS
 $BODY$
 DECLARE
     __fork_id BIGINT;
+    __event_id BIGINT;
 BEGIN
     INSERT INTO hive.fork(block_num, time_of_fork)
     VALUES( _block_num_before_fork, LOCALTIMESTAMP );
 
     SELECT MAX(hf.id) INTO __fork_id FROM hive.fork hf;
     INSERT INTO hive.events_queue( event, block_num )
-    VALUES( 'BACK_FROM_FORK', __fork_id );
+    VALUES( 'BACK_FROM_FORK', __fork_id )
+    RETURNING id INTO __event_id;
+    PERFORM hive.notify_event( 'BACK_FROM_FORK', __fork_id );
+
+    UPDATE hive.events_queue_state SET last_fork_event_id = __event_id;
 END;
 $BODY$
 ;
@@ -33,13 +38,21 @@ AS
 $BODY$
 DECLARE
     __fork_id hive.fork.id%TYPE;
+    __event_id BIGINT;
 BEGIN
     SELECT hf.id
     INTO __fork_id
     FROM hive.fork hf ORDER BY hf.id DESC LIMIT 1;
 
     INSERT INTO hive.events_queue( event, block_num )
-        VALUES( 'NEW_BLOCK', _block.num );
+        VALUES( 'NEW_BLOCK', _block.num )
+        RETURNING id INTO __event_id;
+    PERFORM hive.notify_event( 'NEW_BLOCK', _block.num );
+
+    -- the first block after irreversible ones is the next event of contexts which have processed all irreversible blocks
+    UPDATE hive.events_queue_state
+    SET first_reversible_event_id = __event_id
+    WHERE first_reversible_event_id IS NULL AND ( irreversible_block IS NULL OR irreversible_block < _block.num );
 
     INSERT INTO hive.blocks_reversible VALUES( _block.*, __fork_id );
     INSERT INTO hive.transactions_reversible VALUES( ( unnest( _transactions ) ).*, __fork_id );
@@ -70,6 +83,7 @@ BEGIN
     -- application contexts will use the event to clear data in shadow tables
     INSERT INTO hive.events_queue( event, block_num )
     VALUES( 'NEW_IRREVERSIBLE', _block_num );
+    PERFORM hive.notify_event( 'NEW_IRREVERSIBLE', _block_num );
 
     -- copy to irreversible
     PERFORM hive.copy_blocks_to_irreversible( __irreversible_head_block, _block_num );
@@ -87,6 +101,7 @@ BEGIN
     PERFORM hive.remove_obsolete_reversible_data( _block_num );
 
     UPDATE hive.irreversible_data SET consistent_block = _block_num;
+    PERFORM hive.refresh_events_queue_state( _block_num );
 END;
 $BODY$
 ;
@@ -103,6 +118,7 @@ BEGIN
 
     INSERT INTO hive.events_queue( event, block_num )
     VALUES ( 'MASSIVE_SYNC'::hive.event_type, _block_num );
+    PERFORM hive.notify_event( 'MASSIVE_SYNC', _block_num );
 
     --try to increase irreversible blocks for every context
     PERFORM hive.refresh_irreversible_block_for_all_contexts( _block_num );
@@ -110,6 +126,7 @@ BEGIN
     PERFORM hive.remove_obsolete_reversible_data( _block_num );
 
     UPDATE hive.irreversible_data SET consistent_block = _block_num;
+    PERFORM hive.refresh_events_queue_state( _block_num );
 END;
 $BODY$
 ;
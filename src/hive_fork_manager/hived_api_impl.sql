@@ -304,6 +304,32 @@ END;
 $BODY$
 ;
 
+-- finds again ids of hive.events_queue_state after a new irreversible block, when events may have been removed
+CREATE OR REPLACE FUNCTION hive.refresh_events_queue_state( _irreversible_block INT )
+    RETURNS void
+    LANGUAGE plpgsql
+    VOLATILE
+AS
+$BODY$
+BEGIN
+    UPDATE hive.events_queue_state
+    SET
+          irreversible_block = _irreversible_block
+        , irreversible_event_id = (
+            SELECT MIN( heq.id ) FROM hive.events_queue heq
+            WHERE heq.block_num = _irreversible_block AND ( heq.event = 'NEW_IRREVERSIBLE' OR heq.event = 'MASSIVE_SYNC' )
+          )
+        , first_reversible_event_id = (
+            SELECT MIN( heq.id ) FROM hive.events_queue heq
+            WHERE heq.block_num > _irreversible_block AND heq.event != 'BACK_FROM_FORK'
+          )
+        , last_fork_event_id = COALESCE( ( SELECT MAX( heq.id ) FROM hive.events_queue heq WHERE heq.event = 'BACK_FROM_FORK' ), 0 )
+        , last_massive_sync_event_id = COALESCE( ( SELECT MAX( heq.id ) FROM hive.events_queue heq WHERE heq.event = 'MASSIVE_SYNC' ), 0 )
+    ;
+END;
+$BODY$
+;
+
 CREATE OR REPLACE FUNCTION hive.save_and_drop_indexes_constraints( in _schema TEXT, in _table TEXT )
     RETURNS VOID
     AS
@@ -530,3 +556,18 @@ BEGIN
 END;
 $BODY$
 ;
+
+-- Wakes up applications which wait for new events with LISTEN hive_events, the payload is '<event> <block_num>'.
+-- Each context processes all the events, so there is one channel for all of them. Notifications are sent
+-- when the transaction which adds the event is committed.
+CREATE OR REPLACE FUNCTION hive.notify_event( _event hive.event_type, _block_num BIGINT )
+    RETURNS void
+    LANGUAGE plpgsql
+    VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM pg_notify( 'hive_events', _event::TEXT || ' ' || _block_num );
+END;
+$BODY$
+;
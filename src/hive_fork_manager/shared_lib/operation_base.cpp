@@ -1,5 +1,6 @@
 #include "pq_operation_base.hpp"
 
+#include "to_json.hpp"
 #include "to_jsonb.hpp"
 #include "svstream.hpp"
 
@@ -18,6 +19,7 @@
 
 namespace {
 
+/// casts convert each body once, so they do not pay for hashing and copying it into the operation cache
 hive::protocol::operation raw_to_operation( const char* raw_data, uint32 data_length )
 {
   if( !data_length )
@@ -26,36 +28,25 @@ hive::protocol::operation raw_to_operation( const char* raw_data, uint32 data_le
   return fc::raw::unpack_from_char_array< hive::protocol::operation >( raw_data, static_cast< uint32_t >( data_length ) );
 }
 
-fc::variant op_to_variant_impl( const char* raw_data, uint32 data_length )
-{
-  if( !data_length )
-    return {};
-
-  using hive::protocol::operation;
-
-  operation op = fc::raw::unpack_from_char_array< operation >( raw_data, static_cast< uint32_t >( data_length ) );
-
-  fc::variant v;
-  fc::to_variant( op, v );
-
-  return v;
-}
-
-std::string op_to_json( const char* raw_data, uint32 data_length )
+void op_to_json( const char* raw_data, uint32 data_length, StringInfo out )
 {
   try
   {
-    return fc::json::to_string( op_to_variant_impl( raw_data, data_length ) );
+    if( !data_length )
+    {
+      appendStringInfoString( out, "null" );
+      return;
+    }
+
+    operation_to_json( raw_to_operation( raw_data, data_length ), false, out );
   }
   catch( const fc::exception& e )
   {
     ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "%s", e.to_string().c_str() ) ) );
-    return {};
   }
   catch( ... )
   {
     ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "Unexpected binary to text conversion occured" ) ) );
-    return {};
   }
 }
 
@@ -112,6 +103,30 @@ extern "C"
     return memcmp( VARDATA_ANY( lhs ), VARDATA_ANY( rhs ), VARSIZE_ANY_EXHDR( lhs ) );
   }
 
+  int32 operation_type_id_impl( const _operation* op )
+  {
+    const auto* raw_data = reinterpret_cast< const uint8* >( VARDATA_ANY( op ) );
+    const uint32 data_length = VARSIZE_ANY_EXHDR( op );
+    if( !data_length )
+      return -1;
+
+    // the tag of static_variant is packed as fc::unsigned_int, 7 bits in each byte
+    uint32 type_id = 0;
+    for( uint32 i = 0, shift = 0; i < data_length && shift < 32; ++i, shift += 7 )
+    {
+      type_id |= static_cast< uint32 >( raw_data[ i ] & 0x7f ) << shift;
+      if( !( raw_data[ i ] & 0x80 ) )
+      {
+        if( type_id >= static_cast< uint32 >( hive::protocol::operation::count() ) )
+          ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "Unknown operation type %u", type_id ) ) );
+        return static_cast< int32 >( type_id );
+      }
+    }
+
+    ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "Operation type is not terminated" ) ) );
+    return -1;
+  }
+
   Datum operation_to_jsonb( PG_FUNCTION_ARGS )
   {
     _operation* op = PG_GETARG_HIVE_OPERATION_PP( 0 );
@@ -161,14 +176,53 @@ extern "C"
     uint32 data_length   = VARSIZE_ANY_EXHDR( op );
     const char* raw_data = VARDATA_ANY( op );
 
-    std::string op_str = op_to_json( raw_data, data_length ); // Get json from raw bytes
+    StringInfoData json;
+    initStringInfo( &json );
+    op_to_json( raw_data, data_length, &json ); // Write json from raw bytes straight to postgres memory
+
+    PG_RETURN_CSTRING( json.data );
+  }
+
+  Datum operation_type_id( PG_FUNCTION_ARGS )
+  {
+    _operation* op = PG_GETARG_HIVE_OPERATION_PP( 0 );
+
+    const int32 type_id = operation_type_id_impl( op );
+    if( type_id < 0 )
+      PG_RETURN_NULL();
+
+    PG_RETURN_INT16( static_cast< int16 >( type_id ) );
+  }
+
+  Datum operation_field_text( PG_FUNCTION_ARGS )
+  {
+    _operation* op    = PG_GETARG_HIVE_OPERATION_PP( 0 );
+    const char* field = text_to_cstring( PG_GETARG_TEXT_PP( 1 ) );
 
-    uint32 op_ccp_size = op_str.size() + 1;
-    char* op_ccp       = (char*) palloc( op_ccp_size ); // allocate space for postgres cstring
+    StringInfoData value;
+    initStringInfo( &value );
+    // the text is written after room for the varlena header and returned without copying
+    appendStringInfoSpaces( &value, VARHDRSZ );
+
+    bool found = false;
+    try
+    {
+      found = operation_field_to_text( VARDATA_ANY( op ), VARSIZE_ANY_EXHDR( op ), field, &value );
+    }
+    catch( const fc::exception& e )
+    {
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "%s", e.to_string().c_str() ) ) );
+    }
+    catch( ... )
+    {
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "Could not read field %s of operation", field ) ) );
+    }
 
-    const char* cstring_out = (const char*) memcpy( op_ccp, op_str.c_str(), op_ccp_size ); // copy json content from std::string to postgres cstring
+    if( !found )
+      PG_RETURN_NULL();
 
-    PG_RETURN_CSTRING( cstring_out );
+    SET_VARSIZE( value.data, value.len );
+    PG_RETURN_TEXT_P( reinterpret_cast< text* >( value.data ) );
   }
 
   Datum operation_bin_in_internal( PG_FUNCTION_ARGS )
@@ -16,4 +16,7 @@ extern "C"
 #define DatumGetHiveOperationPP( X )     ( (_operation*) PG_DETOAST_DATUM_PACKED( X ) )
 #define PG_GETARG_HIVE_OPERATION_PP( n ) DatumGetHiveOperationPP( PG_GETARG_DATUM( n ) )
 
+  // id of the operation type read from the tag in front of the raw data without unpacking the operation, -1 for an empty operation
+  int32 operation_type_id_impl( const _operation* op );
+
 }
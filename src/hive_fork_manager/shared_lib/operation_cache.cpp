@@ -0,0 +1,100 @@
+#include "operation_cache.hpp"
+
+#include <include/psql_utils/postgres_includes.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <array>
+#include <cstring>
+#include <string>
+
+namespace {
+
+constexpr size_t CACHED_OPERATIONS = 8;
+
+/// entries are found by a hash and the raw data, not by address of the datum: a toasted body is detoasted into
+/// a new buffer by each function, and a buffer of one row may be reused by another row
+struct cached_operation
+{
+  uint32 hash = 0;
+  std::string raw_data;
+  std::shared_ptr< const hive::protocol::operation > operation;
+};
+
+struct operation_cache
+{
+  /// context of the query, the cache is cleared when the context is reset or deleted
+  MemoryContext query_context = nullptr;
+  std::array< cached_operation, CACHED_OPERATIONS > entries;
+  size_t next_entry = 0;
+
+  void clear()
+  {
+    for( auto& entry : entries )
+      entry = cached_operation{};
+    next_entry = 0;
+    query_context = nullptr;
+  }
+};
+
+operation_cache cache;
+
+void on_query_context_reset( void* context )
+{
+  // the cache may have been bound to another context since the callback was registered
+  if( cache.query_context == context )
+    cache.clear();
+}
+
+/// MessageContext is reset after each query of a client, background and parallel workers have only the transaction
+MemoryContext current_query_context()
+{
+  return MessageContext != nullptr ? MessageContext : TopTransactionContext;
+}
+
+void bind_to_current_query()
+{
+  MemoryContext context = current_query_context();
+  if( cache.query_context == context )
+    return;
+
+  cache.clear();
+  if( context == nullptr )
+    return;
+
+  auto* callback = static_cast< MemoryContextCallback* >( MemoryContextAllocZero( context, sizeof( MemoryContextCallback ) ) );
+  callback->func = on_query_context_reset;
+  callback->arg = context;
+  MemoryContextRegisterResetCallback( context, callback );
+  cache.query_context = context;
+}
+
+} // namespace
+
+std::shared_ptr< const hive::protocol::operation > unpack_operation_cached( const char* raw_data, uint32_t data_length )
+{
+  bind_to_current_query();
+
+  const uint32 hash = hash_bytes( reinterpret_cast< const unsigned char* >( raw_data ), static_cast< int >( data_length ) );
+  for( const auto& entry : cache.entries )
+  {
+    if( entry.operation && entry.hash == hash && entry.raw_data.size() == data_length
+      && std::memcmp( entry.raw_data.data(), raw_data, data_length ) == 0 )
+      return entry.operation;
+  }
+
+  auto operation = std::make_shared< hive::protocol::operation >();
+  fc::raw::unpack_from_char_array( raw_data, data_length, *operation );
+
+  // without a query the operation is not cached, nothing would clear it
+  if( cache.query_context != nullptr )
+  {
+    auto& entry = cache.entries[ cache.next_entry ];
+    entry.hash = hash;
+    entry.raw_data.assign( raw_data, data_length );
+    entry.operation = operation;
+    cache.next_entry = ( cache.next_entry + 1 ) % CACHED_OPERATIONS;
+  }
+
+  return operation;
+}
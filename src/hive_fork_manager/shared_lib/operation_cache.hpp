@@ -0,0 +1,9 @@
+#pragma once
+#include <hive/protocol/operations.hpp>
+
+#include <memory>
+
+/// the operation unpacked from the raw data, operations unpacked during a query are cached, so the same body passed to
+/// several functions ( or to one function expanded for each column of its result ) is unpacked only once
+/// functions which unpack each body once, like the casts to jsonb and text, should not use it: they would pay for the hash and copy of the body
+std::shared_ptr< const hive::protocol::operation > unpack_operation_cached( const char* raw_data, uint32_t data_length );
@@ -25,6 +25,13 @@ extern "C"
   PG_FUNCTION_INFO_V1( operation_out );
   Datum operation_out( PG_FUNCTION_ARGS );
 
+  /// operation accessors
+  PG_FUNCTION_INFO_V1( operation_type_id );
+  Datum operation_type_id( PG_FUNCTION_ARGS );
+
+  PG_FUNCTION_INFO_V1( operation_field_text );
+  Datum operation_field_text( PG_FUNCTION_ARGS );
+
   PG_FUNCTION_INFO_V1( operation_bin_in_internal );
   Datum operation_bin_in_internal( PG_FUNCTION_ARGS );
 
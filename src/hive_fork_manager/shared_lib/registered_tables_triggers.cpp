@@ -0,0 +1,215 @@
+#include <include/psql_utils/postgres_includes.hpp>
+
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * State of a context read once per transaction. hive.contexts are changed by functions called by the context owner
+ * ( hive.context_next_block, hive.context_back_from_fork, ... ), each change clears the cache with a trigger on hive.contexts,
+ * the cache is cleared also at the end of a transaction and when a subtransaction is rolled back.
+ */
+struct context_state
+{
+  int32 current_block_num = 0;
+  int32 irreversible_block = 0;
+  bool back_from_fork = false;
+};
+
+std::unordered_map< int32, context_state > contexts_cache;
+
+/// plans of inserts to shadow tables by names of shadow tables and trigger events, they live as long as the backend
+std::unordered_map< std::string, SPIPlanPtr > shadow_table_insert_plans;
+
+SPIPlanPtr context_state_plan = nullptr;
+
+bool cache_callbacks_registered = false;
+
+void on_transaction_event( XactEvent /*event*/, void* /*arg*/ )
+{
+  contexts_cache.clear();
+}
+
+void on_subtransaction_event( SubXactEvent event, SubTransactionId /*my_subid*/, SubTransactionId /*parent_subid*/, void* /*arg*/ )
+{
+  if ( event == SUBXACT_EVENT_ABORT_SUB )
+    contexts_cache.clear();
+}
+
+void register_cache_callbacks()
+{
+  if ( cache_callbacks_registered )
+    return;
+
+  RegisterXactCallback( on_transaction_event, nullptr );
+  RegisterSubXactCallback( on_subtransaction_event, nullptr );
+  cache_callbacks_registered = true;
+}
+
+SPIPlanPtr prepare_kept_plan( const char* query, int number_of_args, Oid* args_types )
+{
+  SPIPlanPtr plan = SPI_prepare( query, number_of_args, args_types );
+  if ( plan == nullptr )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "Cannot prepare query %s: %s", query, SPI_result_code_string( SPI_result ) ) ) ); //NOLINT
+
+  if ( SPI_keepplan( plan ) != 0 )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "Cannot save plan of query %s", query ) ) ); //NOLINT
+
+  return plan;
+}
+
+context_state get_context_state( int32 context_id )
+{
+  auto cached = contexts_cache.find( context_id );
+  if ( cached != contexts_cache.end() )
+    return cached->second;
+
+  if ( context_state_plan == nullptr )
+  {
+    Oid args_types[] = { INT4OID };
+    context_state_plan = prepare_kept_plan( "SELECT hc.current_block_num, hc.back_from_fork, hc.irreversible_block FROM hive.contexts hc WHERE hc.id = $1", 1, args_types );
+  }
+
+  Datum args[] = { Int32GetDatum( context_id ) };
+  if ( SPI_execute_plan( context_state_plan, args, nullptr, false, 1 ) != SPI_OK_SELECT )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "Cannot read state of the context %d", context_id ) ) ); //NOLINT
+
+  context_state state;
+  if ( SPI_processed == 1 )
+  {
+    bool is_null = false;
+    state.current_block_num = DatumGetInt32( SPI_getbinval( SPI_tuptable->vals[ 0 ], SPI_tuptable->tupdesc, 1, &is_null ) );
+    state.back_from_fork = DatumGetBool( SPI_getbinval( SPI_tuptable->vals[ 0 ], SPI_tuptable->tupdesc, 2, &is_null ) );
+    state.irreversible_block = DatumGetInt32( SPI_getbinval( SPI_tuptable->vals[ 0 ], SPI_tuptable->tupdesc, 3, &is_null ) );
+  }
+
+  contexts_cache.emplace( context_id, state );
+  return state;
+}
+
+const char* event_name( TriggerEvent event )
+{
+  if ( TRIGGER_FIRED_BY_INSERT( event ) )
+    return "insert";
+  if ( TRIGGER_FIRED_BY_DELETE( event ) )
+    return "delete";
+  if ( TRIGGER_FIRED_BY_UPDATE( event ) )
+    return "update";
+  return "truncate";
+}
+
+/// the same inserts as the former plpgsql trigger functions did, the block number is the only parameter
+const char* make_shadow_table_insert_query( TriggerData* trigger_data, const char* shadow_table )
+{
+  const Trigger* trigger = trigger_data->tg_trigger;
+
+  if ( TRIGGER_FIRED_BY_INSERT( trigger_data->tg_event ) )
+    return psprintf( "INSERT INTO hive.%s SELECT n.*, $1, 'INSERT' FROM %s n ON CONFLICT DO NOTHING"
+      , quote_identifier( shadow_table ), quote_identifier( trigger->tgnewtable ) );
+
+  if ( TRIGGER_FIRED_BY_DELETE( trigger_data->tg_event ) )
+    return psprintf( "INSERT INTO hive.%s SELECT o.*, $1, 'DELETE' FROM %s o ON CONFLICT DO NOTHING"
+      , quote_identifier( shadow_table ), quote_identifier( trigger->tgoldtable ) );
+
+  if ( TRIGGER_FIRED_BY_UPDATE( trigger_data->tg_event ) )
+    return psprintf( "INSERT INTO hive.%s SELECT o.*, $1, 'UPDATE' FROM %s o ON CONFLICT DO NOTHING"
+      , quote_identifier( shadow_table ), quote_identifier( trigger->tgoldtable ) );
+
+  // truncate
+  Relation table = trigger_data->tg_relation;
+  return psprintf( "INSERT INTO hive.%s SELECT o.*, $1, 'DELETE' FROM %s.%s o ON CONFLICT DO NOTHING"
+    , quote_identifier( shadow_table )
+    , quote_identifier( get_namespace_name( RelationGetNamespace( table ) ) )
+    , quote_identifier( RelationGetRelationName( table ) )
+  );
+}
+
+SPIPlanPtr get_shadow_table_insert_plan( TriggerData* trigger_data, const char* shadow_table )
+{
+  const std::string key = std::string( shadow_table ) + ':' + event_name( trigger_data->tg_event );
+
+  auto cached = shadow_table_insert_plans.find( key );
+  if ( cached != shadow_table_insert_plans.end() )
+    return cached->second;
+
+  Oid args_types[] = { INT4OID };
+  SPIPlanPtr plan = prepare_kept_plan( make_shadow_table_insert_query( trigger_data, shadow_table ), 1, args_types );
+  shadow_table_insert_plans.emplace( key, plan );
+  return plan;
+}
+
+} // namespace
+
+extern "C"
+{
+
+/**
+ * The only trigger function of registered tables, hive.on_registered_table_change, bound directly by statement
+ * triggers created for INSERT, UPDATE, DELETE and TRUNCATE of each registered table.
+ * Arguments of the trigger: id of the context and name of the shadow table. Changed rows are written to the shadow
+ * table with a plan prepared once per table and event. State of the context is read once per transaction
+ * into the contexts cache, which is cleared when hive.contexts change, at the end of a transaction and on
+ * a subtransaction rollback. Nothing is written while the context is back from a fork or processes irreversible blocks.
+ */
+PG_FUNCTION_INFO_V1(on_registered_table_change);
+
+Datum on_registered_table_change(PG_FUNCTION_ARGS)
+{
+  if ( !CALLED_AS_TRIGGER( fcinfo ) )
+    ereport( ERROR, ( errcode( ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED ), errmsg( "on_registered_table_change: not called by trigger manager" ) ) ); //NOLINT
+
+  auto* trigger_data = reinterpret_cast< TriggerData* >( fcinfo->context );
+  if ( !TRIGGER_FIRED_FOR_STATEMENT( trigger_data->tg_event ) || trigger_data->tg_trigger->tgnargs != 2 )
+    ereport( ERROR, ( errcode( ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED ), errmsg( "on_registered_table_change: has to be a statement trigger with a context id and a shadow table name" ) ) ); //NOLINT
+
+  register_cache_callbacks();
+
+  const int32 context_id = pg_strtoint32( trigger_data->tg_trigger->tgargs[ 0 ] );
+  const char* shadow_table = trigger_data->tg_trigger->tgargs[ 1 ];
+
+  if ( SPI_connect() != SPI_OK_CONNECT )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "on_registered_table_change: SPI_connect failed" ) ) ); //NOLINT
+
+  const context_state state = get_context_state( context_id );
+
+  if ( state.back_from_fork )
+  {
+    SPI_finish();
+    return PointerGetDatum( nullptr );
+  }
+
+  if ( state.current_block_num <= 0 )
+    ereport( ERROR, ( errcode( ERRCODE_RAISE_EXCEPTION ), errmsg( "Did not execute hive.context_next_block before table edition" ) ) ); //NOLINT
+
+  // an irreversible block is never reverted, its changes would be only removed by hive.remove_obsolete_operations
+  if ( state.current_block_num <= state.irreversible_block )
+  {
+    SPI_finish();
+    return PointerGetDatum( nullptr );
+  }
+
+  if ( SPI_register_trigger_data( trigger_data ) != SPI_OK_TD_REGISTER )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "on_registered_table_change: SPI_register_trigger_data failed" ) ) ); //NOLINT
+
+  Datum args[] = { Int32GetDatum( state.current_block_num ) };
+  if ( SPI_execute_plan( get_shadow_table_insert_plan( trigger_data, shadow_table ), args, nullptr, false, 0 ) != SPI_OK_INSERT )
+    ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "Cannot write changes of a registered table to the shadow table hive.%s", shadow_table ) ) ); //NOLINT
+
+  SPI_finish();
+  return PointerGetDatum( nullptr );
+}
+
+/// bound to a trigger on hive.contexts, a context changed in a transaction has to be read again by on_registered_table_change
+PG_FUNCTION_INFO_V1(on_contexts_change);
+
+Datum on_contexts_change(PG_FUNCTION_ARGS)
+{
+  if ( !CALLED_AS_TRIGGER( fcinfo ) )
+    ereport( ERROR, ( errcode( ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED ), errmsg( "on_contexts_change: not called by trigger manager" ) ) ); //NOLINT
+
+  contexts_cache.clear();
+  return PointerGetDatum( nullptr );
+}
+
+} // extern "C"
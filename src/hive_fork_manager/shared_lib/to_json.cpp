@@ -0,0 +1,611 @@
+#include "to_json.hpp"
+
+#include <include/psql_utils/postgres_includes.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/crypto/hex.hpp>
+#include <fc/io/datastream.hpp>
+#include <fc/io/json.hpp>
+#include <fc/io/raw.hpp>
+
+#include <hive/protocol/types_fwd.hpp>
+
+#include <boost/container/flat_set.hpp>
+#include <boost/container/flat_map.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using hive::protocol::serialization_mode_controller;
+using hive::protocol::transaction_serialization_type;
+
+/// format of the text being written, set by every entry point, so a conversion interrupted by an error does not affect later ones
+bool legacy_format = false;
+
+void append_text(const std::string& text, StringInfo out)
+{
+  appendBinaryStringInfo(out, text.data(), text.size());
+}
+
+template<size_t N>
+void append_literal(const char (&text)[N], StringInfo out)
+{
+  appendBinaryStringInfo(out, text, N - 1);
+}
+
+/// the same escaping as fc::json::to_string, characters which need no escaping are copied in runs
+void append_json_string(const char* str, size_t len, StringInfo out)
+{
+  appendStringInfoChar(out, '"');
+  const char* run = str;
+  const char* const end = str + len;
+  for (const char* c = str; c != end; ++c)
+  {
+    const auto code = static_cast<unsigned char>(*c);
+    if (code >= 0x20 && code != '"' && code != '\\')
+      continue;
+
+    appendBinaryStringInfo(out, run, c - run);
+    run = c + 1;
+    switch (code)
+    {
+      case '"': append_literal("\\\"", out); break;
+      case '\\': append_literal("\\\\", out); break;
+      case '\b': append_literal("\\b", out); break;
+      case '\f': append_literal("\\f", out); break;
+      case '\n': append_literal("\\n", out); break;
+      case '\r': append_literal("\\r", out); break;
+      case '\t': append_literal("\\t", out); break;
+      default: appendStringInfo(out, "\\u%04x", code); break;
+    }
+  }
+  appendBinaryStringInfo(out, run, end - run);
+  appendStringInfoChar(out, '"');
+}
+
+void append_json_string(const std::string& value, StringInfo out)
+{
+  append_json_string(value.data(), value.length(), out);
+}
+
+template<typename Integer>
+void append_integer(Integer value, StringInfo out)
+{
+  char buffer[24];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  appendBinaryStringInfo(out, buffer, result.ptr - buffer);
+}
+
+template<typename Integer>
+void append_large_integer(Integer value, StringInfo out)
+{
+  // Numeric types are written either as numbers or as strings, like fc::json::to_string does.
+  // If value can be represented in 32bits, it's written as a number. Otherwise it's written as a string.
+  if (value <= 0xffffffff)
+  {
+    append_integer(value, out);
+  }
+  else
+  {
+    appendStringInfoChar(out, '"');
+    append_integer(value, out);
+    appendStringInfoChar(out, '"');
+  }
+}
+
+/// Keys of members of a reflected type with quotes and colons, built once per type from names given to FC_REFLECT.
+template<typename T>
+class reflected_keys
+{
+  public:
+    static const std::vector<std::string>& get()
+    {
+      static const std::vector<std::string> keys = []
+      {
+        std::vector<std::string> result;
+        fc::reflector<T>::visit(collector{result});
+        return result;
+      }();
+      return keys;
+    }
+
+  private:
+    struct collector
+    {
+      std::vector<std::string>& keys;
+
+      template<typename Member, class Class, Member (Class::*member)>
+      void operator()(const char* name) const
+      {
+        keys.push_back('"' + std::string(name) + "\":");
+      }
+    };
+};
+
+/// text written before a value of a static variant, {"type":"<name>","value": in the standard format,
+/// ["<name without _operation>", in the legacy format of operations; computed once per type
+template<typename T>
+class type_prefixes
+{
+  public:
+    static const std::string& standard()
+    {
+      static const std::string prefix = "{\"type\":\"" + trimmed_name() + "\",\"value\":";
+      return prefix;
+    }
+
+    static const std::string& legacy()
+    {
+      static const std::string prefix = []
+      {
+        static const std::string suffix = "_operation";
+        std::string name = trimmed_name();
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+          name.erase(name.size() - suffix.size());
+        return "[\"" + name + "\",";
+      }();
+      return prefix;
+    }
+
+  private:
+    static std::string trimmed_name()
+    {
+      return fc::trim_typename_namespace(fc::get_typename<T>::name());
+    }
+};
+
+template<typename T>
+void to_json(const T& t, StringInfo out);
+void to_json(bool value, StringInfo out);
+void to_json(int16_t value, StringInfo out);
+void to_json(int32_t value, StringInfo out);
+void to_json(int64_t value, StringInfo out);
+void to_json(uint8_t value, StringInfo out);
+void to_json(uint16_t value, StringInfo out);
+void to_json(uint32_t value, StringInfo out);
+void to_json(uint64_t value, StringInfo out);
+void to_json(const std::string& value, StringInfo out);
+void to_json(const std::vector<char>& value, StringInfo out);
+template<typename T>
+void to_json(const std::vector<T>& value, StringInfo out);
+template<typename A, typename B>
+void to_json(const std::pair<A, B>& value, StringInfo out);
+void to_json(const hive::protocol::fixed_string<16>& value, StringInfo out);
+template<typename Storage>
+void to_json(const hive::protocol::fixed_string_impl<Storage>& value, StringInfo out);
+void to_json(const hive::protocol::json_string& value, StringInfo out);
+void to_json(const hive::protocol::asset& value, StringInfo out);
+void to_json(const hive::protocol::legacy_asset& value, StringInfo out);
+void to_json(const hive::protocol::legacy_hive_asset& value, StringInfo out);
+void to_json(const hive::protocol::public_key_type& value, StringInfo out);
+template<typename T>
+void to_json(const fc::safe<T>& value, StringInfo out);
+template<typename T>
+void to_json(const fc::optional<T>& t, StringInfo out);
+void to_json(const hive::protocol::operation& value, StringInfo out);
+template<typename... Types>
+void to_json(const fc::static_variant<Types...>& value, StringInfo out);
+template<typename T, size_t N>
+void to_json(const fc::array<T, N>& value, StringInfo out);
+void to_json(const fc::time_point_sec& value, StringInfo out);
+void to_json(const fc::ripemd160& value, StringInfo out);
+void to_json(const fc::sha256& value, StringInfo out);
+template<typename T>
+void to_json(const boost::container::flat_set<T>& value, StringInfo out);
+template<typename T>
+void to_json(const flat_set_ex<T>& value, StringInfo out);
+template<typename K, typename... T>
+void to_json(const boost::container::flat_map<K, T...>& value, StringInfo out);
+
+/// fc::to_variant of a reflected type does not add members which are empty optionals
+template<typename T>
+bool is_skipped_member(const T& /*value*/)
+{
+  return false;
+}
+template<typename T>
+bool is_skipped_member(const fc::optional<T>& value)
+{
+  return !value.valid();
+}
+
+template<typename T>
+class member_to_json_visitor
+{
+  public:
+    member_to_json_visitor(const T& obj, StringInfo out) :
+      obj(obj), out(out), keys(reflected_keys<T>::get())
+    {}
+
+    template<typename Member, class Class, Member (Class::*member)>
+    void operator()(const char* /*name*/) const
+    {
+      // members are visited in the same order as their keys were collected
+      const std::string& key = keys[next_key++];
+      if (is_skipped_member(obj.*member))
+        return;
+
+      if (written_members++ != 0)
+        appendStringInfoChar(out, ',');
+      append_text(key, out);
+      to_json(obj.*member, out);
+    }
+
+  private:
+    const T& obj;
+    StringInfo out;
+    const std::vector<std::string>& keys;
+    mutable size_t next_key = 0;
+    mutable size_t written_members = 0;
+};
+
+class static_variant_to_json_visitor
+{
+  public:
+    using result_type = void;
+
+    static_variant_to_json_visitor(StringInfo out, bool legacy_operation) : out(out), legacy_operation(legacy_operation)
+    {}
+
+    template<typename T>
+    void operator()(const T& o) const
+    {
+      if (legacy_operation)
+      {
+        append_text(type_prefixes<T>::legacy(), out);
+        to_json(o, out);
+        appendStringInfoChar(out, ']');
+      }
+      else
+      {
+        append_text(type_prefixes<T>::standard(), out);
+        to_json(o, out);
+        appendStringInfoChar(out, '}');
+      }
+    }
+
+  private:
+    StringInfo out;
+    bool legacy_operation;
+};
+
+template<typename T>
+void to_json(const T& t, StringInfo out)
+{
+  appendStringInfoChar(out, '{');
+  fc::reflector<T>::visit(member_to_json_visitor<T>(t, out));
+  appendStringInfoChar(out, '}');
+}
+void to_json(bool value, StringInfo out)
+{
+  if (value)
+    append_literal("true", out);
+  else
+    append_literal("false", out);
+}
+void to_json(int16_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void to_json(int32_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void to_json(int64_t value, StringInfo out)
+{
+  append_large_integer(value, out);
+}
+void to_json(uint8_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void to_json(uint16_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void to_json(uint32_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void to_json(uint64_t value, StringInfo out)
+{
+  append_large_integer(value, out);
+}
+void to_json(const std::string& value, StringInfo out)
+{
+  append_json_string(value, out);
+}
+void to_json(const std::vector<char>& value, StringInfo out)
+{
+  append_json_string(fc::to_hex(value), out);
+}
+template<typename T>
+void to_json(const std::vector<T>& value, StringInfo out)
+{
+  appendStringInfoChar(out, '[');
+  for (auto it = value.begin(); it != value.end(); ++it)
+  {
+    if (it != value.begin())
+      appendStringInfoChar(out, ',');
+    to_json(*it, out);
+  }
+  appendStringInfoChar(out, ']');
+}
+template<typename A, typename B>
+void to_json(const std::pair<A, B>& value, StringInfo out)
+{
+  appendStringInfoChar(out, '[');
+  to_json(value.first, out);
+  appendStringInfoChar(out, ',');
+  to_json(value.second, out);
+  appendStringInfoChar(out, ']');
+}
+void to_json(const hive::protocol::fixed_string<16>& value, StringInfo out)
+{
+  append_json_string(static_cast<std::string>(value), out);
+}
+template<typename Storage>
+void to_json(const hive::protocol::fixed_string_impl<Storage>& value, StringInfo out)
+{
+  append_json_string(std::string(value), out);
+}
+void to_json(const hive::protocol::json_string& value, StringInfo out)
+{
+  append_json_string(static_cast<std::string>(value), out);
+}
+void to_json(const hive::protocol::asset& value, StringInfo out)
+{
+  if (legacy_format)
+  {
+    to_json(hive::protocol::legacy_asset(value), out);
+  }
+  else
+  {
+    append_literal("{\"amount\":\"", out);
+    append_integer(value.amount.value, out);
+    append_literal("\",\"precision\":", out);
+    append_integer(value.symbol.decimals(), out);
+    append_literal(",\"nai\":", out);
+    append_json_string(value.symbol.to_nai_string(), out);
+    appendStringInfoChar(out, '}');
+  }
+}
+void to_json(const hive::protocol::legacy_asset& value, StringInfo out)
+{
+  append_json_string(value.to_string(), out);
+}
+void to_json(const hive::protocol::legacy_hive_asset& value, StringInfo out)
+{
+  to_json(value.to_asset<false>(), out);
+}
+void to_json(const hive::protocol::public_key_type& value, StringInfo out)
+{
+  append_json_string(std::string(value), out);
+}
+template<typename T>
+void to_json(const fc::safe<T>& value, StringInfo out)
+{
+  to_json(value.value, out);
+}
+template<typename T>
+void to_json(const fc::optional<T>& t, StringInfo out)
+{
+  if (t.valid())
+    to_json(t.value(), out);
+  else
+    append_literal("null", out);
+}
+void to_json(const hive::protocol::operation& value, StringInfo out)
+{
+  value.visit(static_variant_to_json_visitor(out, legacy_format));
+}
+template<typename... Types>
+void to_json(const fc::static_variant<Types...>& value, StringInfo out)
+{
+  if (legacy_format)
+  {
+    // other static variants than operations are rare in the legacy format, fc writes them exactly as before,
+    // the mode is changed only for fc, nothing there can jump out with a postgres error
+    std::string text;
+    {
+      serialization_mode_controller::mode_guard guard(transaction_serialization_type::legacy);
+      text = fc::json::to_string(value);
+    }
+    append_text(text, out);
+    return;
+  }
+
+  value.visit(static_variant_to_json_visitor(out, false));
+}
+template<typename T, size_t N>
+void to_json(const fc::array<T, N>& value, StringInfo out)
+{
+  append_json_string(fc::to_hex(reinterpret_cast<const char*>(&value), sizeof(value)), out);
+}
+void to_json(const fc::time_point_sec& value, StringInfo out)
+{
+  append_json_string(fc::string(value), out);
+}
+void to_json(const fc::ripemd160& value, StringInfo out)
+{
+  append_json_string(fc::to_hex(reinterpret_cast<const char*>(&value), sizeof(value)), out);
+}
+void to_json(const fc::sha256& value, StringInfo out)
+{
+  append_json_string(fc::to_hex(reinterpret_cast<const char*>(&value), sizeof(value)), out);
+}
+template<typename T>
+void to_json(const boost::container::flat_set<T>& value, StringInfo out)
+{
+  appendStringInfoChar(out, '[');
+  for (auto it = value.begin(); it != value.end(); ++it)
+  {
+    if (it != value.begin())
+      appendStringInfoChar(out, ',');
+    to_json(*it, out);
+  }
+  appendStringInfoChar(out, ']');
+}
+template<typename T>
+void to_json(const flat_set_ex<T>& value, StringInfo out)
+{
+  to_json(static_cast<const boost::container::flat_set<T>&>(value), out);
+}
+template<typename K, typename... T>
+void to_json(const boost::container::flat_map<K, T...>& value, StringInfo out)
+{
+  appendStringInfoChar(out, '[');
+  for (auto it = value.begin(); it != value.end(); ++it)
+  {
+    if (it != value.begin())
+      appendStringInfoChar(out, ',');
+    to_json(*it, out);
+  }
+  appendStringInfoChar(out, ']');
+}
+
+
+/// text of a member like jsonb ->> gives it, strings are not quoted, other values are JSON
+template<typename T>
+void member_to_text(const T& value, StringInfo out)
+{
+  to_json(value, out);
+}
+void member_to_text(int64_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void member_to_text(uint64_t value, StringInfo out)
+{
+  append_integer(value, out);
+}
+void member_to_text(const std::string& value, StringInfo out)
+{
+  append_text(value, out);
+}
+void member_to_text(const hive::protocol::fixed_string<16>& value, StringInfo out)
+{
+  append_text(static_cast<std::string>(value), out);
+}
+template<typename Storage>
+void member_to_text(const hive::protocol::fixed_string_impl<Storage>& value, StringInfo out)
+{
+  append_text(std::string(value), out);
+}
+void member_to_text(const hive::protocol::json_string& value, StringInfo out)
+{
+  append_text(static_cast<std::string>(value), out);
+}
+void member_to_text(const hive::protocol::public_key_type& value, StringInfo out)
+{
+  append_text(std::string(value), out);
+}
+void member_to_text(const fc::time_point_sec& value, StringInfo out)
+{
+  append_text(fc::string(value), out);
+}
+template<typename T>
+void member_to_text(const fc::safe<T>& value, StringInfo out)
+{
+  member_to_text(value.value, out);
+}
+template<typename T>
+void member_to_text(const fc::optional<T>& value, StringInfo out)
+{
+  member_to_text(*value, out);
+}
+
+/// Unpacks members of an operation in the order of serialization until the requested one is found.
+/// The binary form has no fixed offsets, members before the requested one are only skipped over, later ones are not read.
+template<typename T>
+class member_reader
+{
+  public:
+    member_reader(fc::datastream<const char*>& stream, const char* field, StringInfo out) :
+      stream(stream), field(field), out(out)
+    {}
+
+    template<typename Member, class Class, Member (Class::*member)>
+    void operator()(const char* name) const
+    {
+      if (done)
+        return;
+
+      Member value;
+      fc::raw::unpack(stream, value);
+      if (strcmp(name, field) != 0)
+        return;
+
+      done = true;
+      if (is_skipped_member(value))
+        return;
+
+      member_to_text(value, out);
+      found = true;
+    }
+
+    bool is_found() const
+    {
+      return found;
+    }
+
+  private:
+    fc::datastream<const char*>& stream;
+    const char* field;
+    StringInfo out;
+    mutable bool done = false;
+    mutable bool found = false;
+};
+
+class operation_member_reader
+{
+  public:
+    using result_type = bool;
+
+    operation_member_reader(fc::datastream<const char*>& stream, const char* field, StringInfo out) :
+      stream(stream), field(field), out(out)
+    {}
+
+    template<typename T>
+    bool operator()(const T& /*empty*/) const
+    {
+      member_reader<T> reader(stream, field, out);
+      fc::reflector<T>::visit(reader);
+      return reader.is_found();
+    }
+
+  private:
+    fc::datastream<const char*>& stream;
+    const char* field;
+    StringInfo out;
+};
+
+}
+
+bool operation_field_to_text(const char* raw_data, size_t data_length, const char* field, StringInfoData* out)
+{
+  if (!data_length)
+    return false;
+
+  legacy_format = false;
+
+  fc::datastream<const char*> stream(raw_data, data_length);
+  fc::unsigned_int type_id;
+  fc::raw::unpack(stream, type_id);
+  FC_ASSERT(type_id.value < static_cast<uint32_t>(hive::protocol::operation::count()), "Unknown operation type ${t}", ("t", type_id.value));
+
+  // an empty operation of the type only selects members to visit, the data is read from the stream
+  hive::protocol::operation op;
+  op.set_which(type_id.value);
+  return op.visit(operation_member_reader(stream, field, out));
+}
+
+void operation_to_json(const hive::protocol::operation& op, bool legacy, StringInfoData* out)
+{
+  legacy_format = legacy;
+  to_json(op, out);
+}
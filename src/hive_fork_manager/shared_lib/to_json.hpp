@@ -0,0 +1,14 @@
+#pragma once
+#include <hive/protocol/operations.hpp>
+
+extern "C"
+{
+struct StringInfoData;
+}
+
+/// appends JSON text of the operation, in the legacy format of hive::protocol::transaction_serialization_type::legacy when requested
+void operation_to_json(const hive::protocol::operation& op, bool legacy, StringInfoData* out);
+
+/// appends text of the member of the operation as jsonb ->> would give it, the operation is unpacked only up to the member;
+/// false when the operation has no such member or it is an empty optional
+bool operation_field_to_text(const char* raw_data, size_t data_length, const char* field, StringInfoData* out);
@@ -10,30 +10,41 @@
 #include <boost/container/flat_set.hpp>
 #include <boost/container/flat_map.hpp>
 
+#include <cstring>
 #include <string>
 #include <vector>
 
 namespace {
 
-JsonbValue* push_key_to_jsonb(const std::string& key, JsonbParseState** parseState)
+/// a jsonb string which points to the given characters, they have to live until the jsonb value is serialized
+JsonbValue make_jsonb_string(const char* str, size_t len)
 {
-  const char* str = key.c_str();
-  const auto len = key.length();
   JsonbValue jb;
   jb.type = jbvString;
   jb.val.string.len = len;
-  jb.val.string.val = pstrdup(str);
+  jb.val.string.val = const_cast<char*>(str);
+  return jb;
+}
+
+JsonbValue* push_static_key_to_jsonb(const char* key, size_t len, JsonbParseState** parseState)
+{
+  JsonbValue jb = make_jsonb_string(key, len);
   return pushJsonbValue(parseState, WJB_KEY, &jb);
 }
 
+template<size_t N>
+JsonbValue* push_key_to_jsonb(const char (&key)[N], JsonbParseState** parseState)
+{
+  return push_static_key_to_jsonb(key, N - 1, parseState);
+}
+
 JsonbValue* push_string_to_jsonb(const std::string& value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  const char* str = value.c_str();
+  // jsonb strings are not null terminated, one copy to the memory context is enough
   const auto len = value.length();
-  JsonbValue jb;
-  jb.type = jbvString;
-  jb.val.string.len = len;
-  jb.val.string.val = pstrdup(str);
+  char* str = static_cast<char*>(palloc(len));
+  memcpy(str, value.data(), len);
+  JsonbValue jb = make_jsonb_string(str, len);
   return pushJsonbValue(parseState, token, &jb);
 }
 
@@ -45,15 +56,12 @@ JsonbValue* push_bool_to_jsonb(bool value, JsonbIteratorToken token, JsonbParseS
   return pushJsonbValue(parseState, token, &jb);
 }
 
-JsonbValue* push_numeric_to_jsonb(const std::string& num, JsonbIteratorToken token, JsonbParseState** parseState)
+JsonbValue* push_numeric_to_jsonb(const int64_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
   JsonbValue jb;
   jb.type = jbvNumeric;
-  // Call the builtin Postgres function that converts text to numeric type.
-  jb.val.numeric = DatumGetNumeric(DirectFunctionCall3(numeric_in,
-      CStringGetDatum(num.c_str()),
-      ObjectIdGetDatum(InvalidOid), // not used
-      Int32GetDatum(-1))); // default type modifier
+  // build numeric directly, without printing the value and parsing it with numeric_in
+  jb.val.numeric = int64_to_numeric(value);
   return pushJsonbValue(parseState, token, &jb);
 }
 
@@ -65,7 +73,7 @@ JsonbValue* push_uint64_to_jsonb(const uint64_t value, JsonbIteratorToken token,
   // This makes the operation::jsonb conversion in sync with the operation::text::jsonb conversion.
   if (value <= 0xffffffff)
   {
-    return push_numeric_to_jsonb(std::to_string(value), token, parseState);
+    return push_numeric_to_jsonb(static_cast<int64_t>(value), token, parseState);
   }
   else
   {
@@ -80,7 +88,7 @@ JsonbValue* push_int64_to_jsonb(const int64_t value, JsonbIteratorToken token, J
   // This makes the operation::jsonb conversion in sync with the operation::text::jsonb conversion.
   if (value <= 0xffffffff)
   {
-    return push_numeric_to_jsonb(std::to_string(value), token, parseState);
+    return push_numeric_to_jsonb(value, token, parseState);
   }
   else
   {
@@ -88,6 +96,44 @@ JsonbValue* push_int64_to_jsonb(const int64_t value, JsonbIteratorToken token, J
   }
 }
 
+/// Keys of members of a reflected type, built once per type from names given to FC_REFLECT.
+/// The names are string literals, so the keys point to them and are never copied.
+template<typename T>
+class reflected_keys
+{
+  public:
+    static const std::vector<JsonbValue>& get()
+    {
+      static const std::vector<JsonbValue> keys = []
+      {
+        std::vector<JsonbValue> result;
+        fc::reflector<T>::visit(collector{result});
+        return result;
+      }();
+      return keys;
+    }
+
+  private:
+    struct collector
+    {
+      std::vector<JsonbValue>& keys;
+
+      template<typename Member, class Class, Member (Class::*member)>
+      void operator()(const char* name) const
+      {
+        keys.push_back(make_jsonb_string(name, strlen(name)));
+      }
+    };
+};
+
+/// name of an operation type without namespaces, computed once per type
+template<typename T>
+const std::string& trimmed_type_name()
+{
+  static const std::string name = fc::trim_typename_namespace(fc::get_typename<T>::name());
+  return name;
+}
+
 template<typename T>
 void to_jsonb(const T& t, JsonbIteratorToken token, JsonbParseState** parseState);
 void to_jsonb(bool value, JsonbIteratorToken token, JsonbParseState** parseState);
@@ -134,19 +180,23 @@ class member_to_jsonb_visitor
 {
   public:
     member_to_jsonb_visitor(const T& obj, JsonbParseState** state) :
-      obj(obj), parseState(state)
+      obj(obj), parseState(state), keys(reflected_keys<T>::get())
     {}
 
     template<typename Member, class Class, Member (Class::*member)>
-    void operator()(const char* name) const
+    void operator()(const char* /*name*/) const
     {
-      push_key_to_jsonb(name, parseState);
+      // members are visited in the same order as their keys were collected
+      JsonbValue key = keys[next_key++];
+      pushJsonbValue(parseState, WJB_KEY, &key);
       to_jsonb(obj.*member, WJB_VALUE, parseState);
     }
 
   private:
     const T& obj;
     mutable JsonbParseState** parseState;
+    const std::vector<JsonbValue>& keys;
+    mutable size_t next_key = 0;
 };
 
 class static_variant_to_jsonb_visitor
@@ -162,9 +212,10 @@ class static_variant_to_jsonb_visitor
     {
       pushJsonbValue(parseState, WJB_BEGIN_OBJECT, NULL);
       // type
-      const auto type_name = fc::trim_typename_namespace(fc::get_typename<T>::name());
+      const auto& type_name = trimmed_type_name<T>();
       push_key_to_jsonb("type", parseState);
-      push_string_to_jsonb(type_name, WJB_VALUE, parseState);
+      JsonbValue type = make_jsonb_string(type_name.data(), type_name.length());
+      pushJsonbValue(parseState, WJB_VALUE, &type);
       // value
       push_key_to_jsonb("value", parseState);
       to_jsonb(o, WJB_VALUE, parseState);
@@ -188,7 +239,7 @@ void to_jsonb(bool value, JsonbIteratorToken token, JsonbParseState** parseState
 }
 void to_jsonb(int16_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  push_numeric_to_jsonb(std::to_string(value), token, parseState);
+  push_numeric_to_jsonb(value, token, parseState);
 }
 void to_jsonb(int64_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
@@ -196,15 +247,15 @@ void to_jsonb(int64_t value, JsonbIteratorToken token, JsonbParseState** parseSt
 }
 void to_jsonb(uint8_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  push_numeric_to_jsonb(std::to_string(value), token, parseState);
+  push_numeric_to_jsonb(value, token, parseState);
 }
 void to_jsonb(uint16_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  push_numeric_to_jsonb(std::to_string(value), token, parseState);
+  push_numeric_to_jsonb(value, token, parseState);
 }
 void to_jsonb(uint32_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  push_numeric_to_jsonb(std::to_string(value), token, parseState);
+  push_numeric_to_jsonb(value, token, parseState);
 }
 void to_jsonb(uint64_t value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
@@ -238,12 +289,7 @@ void to_jsonb(const std::pair<A, B>& value, JsonbIteratorToken token, JsonbParse
 }
 void to_jsonb(const hive::protocol::fixed_string<16>& value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  const std::string str = static_cast<std::string>(value);
-  JsonbValue jb;
-  jb.type = jbvString;
-  jb.val.string.len = str.length();
-  jb.val.string.val = pstrdup(str.c_str());
-  pushJsonbValue(parseState, token, &jb);
+  push_string_to_jsonb(static_cast<std::string>(value), token, parseState);
 }
 template<typename Storage>
 void to_jsonb(const hive::protocol::fixed_string_impl<Storage>& value, JsonbIteratorToken token, JsonbParseState** parseState)
@@ -252,12 +298,7 @@ void to_jsonb(const hive::protocol::fixed_string_impl<Storage>& value, JsonbIter
 }
 void to_jsonb(const hive::protocol::json_string& value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
-  const std::string str = static_cast<std::string>(value);
-  JsonbValue jb;
-  jb.type = jbvString;
-  jb.val.string.len = str.length();
-  jb.val.string.val = pstrdup(str.c_str());
-  pushJsonbValue(parseState, token, &jb);
+  push_string_to_jsonb(static_cast<std::string>(value), token, parseState);
 }
 void to_jsonb(const hive::protocol::asset& value, JsonbIteratorToken token, JsonbParseState** parseState)
 {
@@ -269,12 +310,11 @@ void to_jsonb(const hive::protocol::asset& value, JsonbIteratorToken token, Json
   {
     pushJsonbValue(parseState, WJB_BEGIN_OBJECT, NULL);
     const auto amount = boost::lexical_cast<std::string>(value.amount.value);
-    const auto precision = std::to_string(value.symbol.decimals());
     const auto nai = value.symbol.to_nai_string();
     push_key_to_jsonb("amount", parseState);
     push_string_to_jsonb(amount, WJB_VALUE, parseState);
     push_key_to_jsonb("precision", parseState);
-    push_numeric_to_jsonb(precision, WJB_VALUE, parseState);
+    push_numeric_to_jsonb(value.symbol.decimals(), WJB_VALUE, parseState);
     push_key_to_jsonb("nai", parseState);
     push_string_to_jsonb(nai, WJB_VALUE, parseState);
     pushJsonbValue(parseState, WJB_END_OBJECT, NULL);
@@ -1,4 +1,6 @@
 #include "operation_base.hpp"
+#include "operation_cache.hpp"
+#include "to_json.hpp"
 
 #include <include/psql_utils/postgres_includes.hpp>
 
@@ -10,6 +12,11 @@
 #include <fc/io/json.hpp>
 #include <fc/string.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <set>
+#include <unordered_set>
 #include <vector>
 
 using hive::protocol::account_name_type;
@@ -69,14 +76,10 @@ void extract_set_witness_properties_impl(extract_set_witness_properties_result_t
   helper.try_fill<fc::string>("url");
 }
 
-fc::string get_legacy_style_operation_impl( const hive::protocol::operation& _op )
+void get_legacy_style_operation_impl( const hive::protocol::operation& _op, StringInfo _out )
 {
-  fc::variant v;
-  fc::to_variant( _op, v );
-
-  serialization_mode_controller::mode_guard guard( transaction_serialization_type::legacy );
-
-  return fc::json::to_string( _op );
+  // the writer does not switch serialization_mode_controller, the global mode would stay legacy if a postgres error jumped out of it
+  operation_to_json( _op, true, _out );
 }
 
 account_name_type get_created_from_account_create_operations_impl( const hive::protocol::operation& _op )
@@ -86,11 +89,10 @@ account_name_type get_created_from_account_create_operations_impl( const hive::p
 
 flat_set<account_name_type> get_accounts( const char* raw_data, uint32_t data_length )
 {
-  hive::protocol::operation _op;
-  fc::raw::unpack_from_char_array( raw_data, data_length, _op );
+  const auto _op = unpack_operation_cached( raw_data, data_length );
 
   flat_set<account_name_type> _impacted;
-  hive::app::operation_get_impacted_accounts( _op, _impacted );
+  hive::app::operation_get_impacted_accounts( *_op, _impacted );
 
   return _impacted;
 }
@@ -112,6 +114,81 @@ collected_keyauth_collection_t collect_keyauths(const hive::protocol::operation&
     return hive::app::operation_get_keyauths(op);
 }
 
+struct type_name_visitor
+{
+  using result_type = std::string;
+
+  template<typename T>
+  std::string operator()( const T& ) const
+  {
+    return fc::get_typename<T>::name();
+  }
+};
+
+/// types of operations which have one of the full type names, the vector is indexed by ids of the types
+std::vector<bool> operation_types_of( const hive::app::stringset& names )
+{
+  std::vector<bool> result( hive::protocol::operation::count(), false );
+  hive::protocol::operation op;
+  for( int32_t type_id = 0; type_id < hive::protocol::operation::count(); ++type_id )
+  {
+    op.set_which( type_id );
+    result[ type_id ] = names.count( op.visit( type_name_visitor() ) ) != 0;
+  }
+  return result;
+}
+
+/// operations used in get_keyauths are recognized by their types
+const std::vector<bool>& keyauths_operation_types()
+{
+  static const std::vector<bool> types = operation_types_of( hive::app::get_operations_used_in_get_keyauths() );
+  return types;
+}
+
+const std::vector<bool>& balance_impacting_operation_types()
+{
+  static const std::vector<bool> types = operation_types_of( hive::app::get_operations_used_in_get_balance_impacting_operations() );
+  return types;
+}
+
+/// keys of hive.operation in GIN indexes, the query of hive.operation @@ text is one of the keys
+const std::string account_gin_key_prefix = "account:";
+const std::string type_gin_key_prefix = "type:";
+
+std::string type_gin_key( int32_t type_id )
+{
+  return type_gin_key_prefix + std::to_string( type_id );
+}
+
+/// impacted accounts and the type of the operation
+std::vector<std::string> operation_gin_keys( const char* raw_data, uint32_t data_length, int32_t type_id )
+{
+  std::vector<std::string> keys;
+  for( const auto& account : get_accounts( raw_data, data_length ) )
+    keys.emplace_back( account_gin_key_prefix + std::string( account ) );
+  keys.emplace_back( type_gin_key( type_id ) );
+  return keys;
+}
+
+/// key which matches the query 'account:<name>' or 'type:<id>', empty for an unknown query
+std::string gin_query_key( const std::string& query )
+{
+  if( query.compare( 0, account_gin_key_prefix.size(), account_gin_key_prefix ) == 0 )
+    return query;
+
+  if( query.compare( 0, type_gin_key_prefix.size(), type_gin_key_prefix ) == 0 )
+  {
+    const char* begin = query.data() + type_gin_key_prefix.size();
+    const char* end = query.data() + query.size();
+    int32_t type_id = -1;
+    const auto result = std::from_chars( begin, end, type_id );
+    if( result.ec == std::errc() && result.ptr == end && type_id >= 0 && type_id < hive::protocol::operation::count() )
+      return type_gin_key( type_id );
+  }
+
+  return std::string{};
+}
+
 } // namespace
 
 //use this template instead of Postgres' MemoryContextSwitchTo
@@ -235,15 +312,21 @@ Datum colect_data_and_fill_returned_recordset(Collect collect, FillReturnTuple f
   return (Datum)0;
 }
 
+/// functions which return one value are called once for a body, so they unpack it without the operation cache
 template<typename Collect, typename FillReturnTuple>
 Datum colect_operation_data_and_fill_returned_recordset(Collect collect,
-  FillReturnTuple fill_return_tuple, const char* C_function_name, const char* raw_data, uint32_t data_length) noexcept
+  FillReturnTuple fill_return_tuple, const char* C_function_name, const char* raw_data, uint32_t data_length,
+  bool use_operation_cache = true) noexcept
 {
   try
   {
-    using hive::protocol::operation;
-
-    operation op = fc::raw::unpack_from_char_array< operation >( raw_data, data_length );
+    std::shared_ptr< const hive::protocol::operation > cached_op;
+    hive::protocol::operation unpacked_op;
+    if( use_operation_cache )
+      cached_op = unpack_operation_cached( raw_data, data_length );
+    else
+      fc::raw::unpack_from_char_array( raw_data, data_length, unpacked_op );
+    const hive::protocol::operation& op = cached_op ? *cached_op : unpacked_op;
 
     return colect_data_and_fill_returned_recordset( [&]{
       collect(op);
@@ -297,6 +380,160 @@ void fill_return_tuples(const Collection& collection, PG_FUNCTION_ARGS, Funcs ..
 
 }
 
+constexpr long OPERATIONS_BATCH_SIZE = 10000;
+
+ArrayType* text_array_of(const std::vector< std::string >& texts)
+{
+  std::vector< Datum > elements;
+  elements.reserve( texts.size() );
+  for( const auto& text : texts )
+    elements.push_back( PointerGetDatum( cstring_to_text_with_len( text.data(), text.size() ) ) );
+
+  return construct_array( elements.data(), elements.size(), TEXTOID, -1, false, 'i' );
+}
+
+/// quoted schema qualified name of the relation, to be put into queries
+std::string relation_name_of(Oid relation)
+{
+  const char* relation_name = get_rel_name( relation );
+  if( relation_name == nullptr )
+    ereport( ERROR, ( errcode( ERRCODE_UNDEFINED_TABLE ), errmsg( "Relation %u does not exist", relation ) ) ); //NOLINT
+
+  return quote_qualified_identifier( get_namespace_name( get_rel_namespace( relation ) ), relation_name );
+}
+
+/**
+ * Reads operations of blocks [first_block, last_block] from the relation ( hive.operations or operations view of a context )
+ * with a cursor, batch by batch. All operations are decoded into the same object. When `types` are given, only operations
+ * of these types are selected by op_type_id, others are not read at all. When `ordered`, operations come in order of their ids.
+ * Memory allocated while a batch is processed is freed after it.
+ */
+template<typename Process>
+void scan_operations_in_range(Oid relation, int32 first_block, int32 last_block, const std::vector<bool>* types, bool ordered, Process process)
+{
+  std::string query = "SELECT id, block_num, body FROM " + relation_name_of( relation ) + " WHERE block_num BETWEEN $1 AND $2";
+
+  Oid argument_types[] = { INT4OID, INT4OID, TEXTARRAYOID };
+  Datum arguments[] = { Int32GetDatum( first_block ), Int32GetDatum( last_block ), (Datum)0 };
+  int number_of_arguments = 2;
+
+  if( types != nullptr )
+  {
+    // ids of the types are read from hive.operation_types once, not compared with their names for each operation
+    std::vector< std::string > type_names;
+    hive::protocol::operation type;
+    for( int32_t type_id = 0; type_id < static_cast< int32_t >( types->size() ); ++type_id )
+    {
+      if( !(*types)[ type_id ] )
+        continue;
+      type.set_which( type_id );
+      type_names.emplace_back( type.visit( type_name_visitor() ) );
+    }
+
+    arguments[ number_of_arguments++ ] = PointerGetDatum( text_array_of( type_names ) );
+    query += " AND op_type_id = ANY( ARRAY( SELECT ot.id FROM hive.operation_types ot WHERE ot.name = ANY( $3 ) ) )";
+  }
+
+  if( ordered )
+    query += " ORDER BY id";
+
+  Portal cursor = SPI_cursor_open_with_args( nullptr, query.c_str(), number_of_arguments, argument_types, arguments, nullptr, true, 0 );
+
+  MemoryContext batch_context = AllocSetContextCreate( CurrentMemoryContext, "operations batch", ALLOCSET_DEFAULT_SIZES );
+  hive::protocol::operation op;
+
+  for( SPI_cursor_fetch( cursor, true, OPERATIONS_BATCH_SIZE ); SPI_processed > 0; SPI_cursor_fetch( cursor, true, OPERATIONS_BATCH_SIZE ) )
+  {
+    MemoryContextSwitcher( batch_context, [&]()
+    {
+      for( uint64 row = 0; row < SPI_processed; ++row )
+      {
+        HeapTuple tuple = SPI_tuptable->vals[ row ];
+        bool is_null = false;
+
+        const Datum body = SPI_getbinval( tuple, SPI_tuptable->tupdesc, 3, &is_null );
+        if( is_null )
+          continue;
+
+        _operation* operation_body = DatumGetHiveOperationPP( body );
+        const int32 type_id = operation_type_id_impl( operation_body );
+        if( type_id < 0 || ( types != nullptr && !(*types)[ type_id ] ) )
+          continue;
+
+        fc::raw::unpack_from_char_array( VARDATA_ANY( operation_body ), VARSIZE_ANY_EXHDR( operation_body ), op );
+
+        const int64 operation_id = DatumGetInt64( SPI_getbinval( tuple, SPI_tuptable->tupdesc, 1, &is_null ) );
+        const int32 block_num = DatumGetInt32( SPI_getbinval( tuple, SPI_tuptable->tupdesc, 2, &is_null ) );
+        process( operation_id, block_num, op );
+      }
+    });
+
+    SPI_freetuptable( SPI_tuptable );
+    MemoryContextReset( batch_context );
+  }
+
+  SPI_cursor_close( cursor );
+  MemoryContextDelete( batch_context );
+}
+
+/**
+ * Batch form of fill_return_tuples for functions ( _first_block INT, _last_block INT, _operations regclass ):
+ * collect fills the collection with items of one operation, each item is returned as a row prefixed with id of the operation.
+ * prepare is called first, when SPI is already connected.
+ */
+template<typename Collection, typename Prepare, typename Collect, typename ... Funcs>
+Datum collect_operations_in_range_and_fill_returned_recordset(PG_FUNCTION_ARGS, const char* C_function_name,
+  const std::vector<bool>* types, Prepare prepare, Collect collect, Funcs ... funcs) noexcept
+{
+  const int32 first_block = PG_GETARG_INT32( 0 );
+  const int32 last_block = PG_GETARG_INT32( 1 );
+  const Oid relation = PG_GETARG_OID( 2 );
+
+  try
+  {
+    check_return_mode(fcinfo);
+
+    TupleDesc retvalDescription = build_tuple_descriptor(fcinfo);
+
+    ReturnSetInfo* rsinfo = reinterpret_cast<ReturnSetInfo*>(fcinfo->resultinfo); //NOLINT
+
+    Tuplestorestate* tupstore = init_tuple_store(rsinfo, retvalDescription);
+
+    const auto TUPLE_LENGTH = 1 + sizeof ... (Funcs);
+
+    Datum tuple_values[TUPLE_LENGTH] = {0};
+    bool nulls[TUPLE_LENGTH] = {false};
+
+    if( SPI_connect() != SPI_OK_CONNECT )
+      issue_error( fc::string( C_function_name ) + ": SPI_connect failed" );
+
+    prepare();
+
+    // the collection is reused for all operations
+    Collection collection;
+    scan_operations_in_range( relation, first_block, last_block, types, false,
+      [&]( int64 operation_id, int32 block_num, const hive::protocol::operation& op )
+      {
+        collect( block_num, op, collection );
+
+        tuple_values[ 0 ] = Int64GetDatum( operation_id );
+        for( const auto& collected_item : collection )
+        {
+          fill_record( tuple_values + 1, collected_item, funcs... );
+
+          tuplestore_putvalues( tupstore, retvalDescription, tuple_values, nulls );
+        }
+      }
+    );
+
+    SPI_finish();
+
+    tuplestore_donestoring(tupstore);
+  } HFM_NOEXCEPT_CAPTURE_AND_ISSUE_ERROR( fc::string(" blocks: ") + std::to_string( first_block ) + " - " + std::to_string( last_block ) )
+
+  return (Datum)0;
+}
+
 
 extern "C"
 {
@@ -326,7 +563,7 @@ Datum get_created_from_account_create_operations(PG_FUNCTION_ARGS)
     },
     [](){},
     __FUNCTION__,
-    VARDATA_ANY( op ), VARSIZE_ANY_EXHDR( op ));
+    VARDATA_ANY( op ), VARSIZE_ANY_EXHDR( op ), false );
 
   return _result;
 }
@@ -370,12 +607,17 @@ Datum get_legacy_style_operation(PG_FUNCTION_ARGS)
   colect_operation_data_and_fill_returned_recordset(
     [=, &_result](const hive::protocol::operation& op)
     {
-        fc::string _legacy_operation_body = get_legacy_style_operation_impl( op );
-        _result = CStringGetTextDatum( _legacy_operation_body.c_str() );
+        StringInfoData _legacy_operation_body;
+        initStringInfo( &_legacy_operation_body );
+        // the text is written after room for the varlena header and returned without copying
+        appendStringInfoSpaces( &_legacy_operation_body, VARHDRSZ );
+        get_legacy_style_operation_impl( op, &_legacy_operation_body );
+        SET_VARSIZE( _legacy_operation_body.data, _legacy_operation_body.len );
+        _result = PointerGetDatum( _legacy_operation_body.data );
     },
     [](){},
     __FUNCTION__,
-    VARDATA_ANY( op ), VARSIZE_ANY_EXHDR( op ));
+    VARDATA_ANY( op ), VARSIZE_ANY_EXHDR( op ), false );
 
   return _result;
 }
@@ -391,8 +633,8 @@ Datum get_impacted_accounts(PG_FUNCTION_ARGS)
     int call_cntr = 0;
     int max_calls = 0;
 
-    static Datum _empty = CStringGetTextDatum("");
-    Datum current_account = _empty;
+    // a static Datum would point to memory of the query which called the function first
+    Datum current_account = (Datum)0;
 
     bool _first_call = SRF_IS_FIRSTCALL();
     /* stuff done only on the first call of the function */
@@ -621,17 +863,20 @@ Datum get_impacted_balances(PG_FUNCTION_ARGS)
   {
     _operation* operation_body = PG_GETARG_HIVE_OPERATION_PP( 0 );
 
-    bool _result = false;
+    // only the type of the operation matters, the body is not unpacked
+    const int32 type_id = operation_type_id_impl( operation_body );
+    if( type_id < 0 )
+      PG_RETURN_BOOL(false);
 
-    colect_operation_data_and_fill_returned_recordset(
-      [=, &_result](const hive::protocol::operation& op)
-      {
-        _result = hive::app::is_keyauths_operation( op );
-      },
-      [](){},
-      __FUNCTION__,
-      VARDATA_ANY( operation_body ), VARSIZE_ANY_EXHDR( operation_body )
-    );
+    bool _result = false;
+    try
+    {
+      _result = keyauths_operation_types()[ type_id ];
+    }
+    catch( const fc::exception& e )
+    {
+      ereport( ERROR, ( errcode( ERRCODE_INTERNAL_ERROR ), errmsg( "%s", e.to_string().c_str() ) ) );
+    }
 
     PG_RETURN_BOOL(_result);
   }
@@ -683,4 +928,291 @@ Datum get_impacted_balances(PG_FUNCTION_ARGS)
 
     return (Datum)0;
   }  
+
+  PG_FUNCTION_INFO_V1(operation_matches);
+
+  /// hive.operation @@ 'account:<name>' - the operation impacts the account, hive.operation @@ 'type:<id>' - the operation has the type
+  Datum operation_matches(PG_FUNCTION_ARGS)
+  {
+    _operation* operation_body = PG_GETARG_HIVE_OPERATION_PP( 0 );
+    const std::string query_key = gin_query_key( text_to_cstring( PG_GETARG_TEXT_PP( 1 ) ) );
+
+    if( query_key.empty() )
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_PARAMETER_VALUE ), errmsg( "Unknown hive.operation query, expected 'account:<name>' or 'type:<id>'" ) ) );
+
+    const int32 type_id = operation_type_id_impl( operation_body );
+    if( type_id < 0 )
+      PG_RETURN_BOOL(false);
+
+    // the type is compared without unpacking the operation
+    if( query_key.compare( 0, type_gin_key_prefix.size(), type_gin_key_prefix ) == 0 )
+      PG_RETURN_BOOL( query_key == type_gin_key( type_id ) );
+
+    bool _result = false;
+    try
+    {
+      const auto keys = operation_gin_keys( VARDATA_ANY( operation_body ), VARSIZE_ANY_EXHDR( operation_body ), type_id );
+      _result = std::find( keys.begin(), keys.end(), query_key ) != keys.end();
+    }
+    catch( const fc::exception& e )
+    {
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "%s", e.to_string().c_str() ) ) );
+    }
+
+    PG_RETURN_BOOL(_result);
+  }
+
+  PG_FUNCTION_INFO_V1(operation_gin_extract_value);
+
+  /// GIN extractValue, keys of an operation are its impacted accounts and its type
+  Datum operation_gin_extract_value(PG_FUNCTION_ARGS)
+  {
+    _operation* operation_body = PG_GETARG_HIVE_OPERATION_PP( 0 );
+    auto* nkeys = reinterpret_cast< int32* >( PG_GETARG_POINTER( 1 ) );
+
+    *nkeys = 0;
+    const int32 type_id = operation_type_id_impl( operation_body );
+    if( type_id < 0 )
+      PG_RETURN_POINTER( nullptr );
+
+    Datum* keys = nullptr;
+    try
+    {
+      const auto operation_keys = operation_gin_keys( VARDATA_ANY( operation_body ), VARSIZE_ANY_EXHDR( operation_body ), type_id );
+      keys = static_cast< Datum* >( palloc( operation_keys.size() * sizeof( Datum ) ) );
+      for( const auto& key : operation_keys )
+        keys[ (*nkeys)++ ] = PointerGetDatum( cstring_to_text_with_len( key.data(), key.size() ) );
+    }
+    catch( const fc::exception& e )
+    {
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_BINARY_REPRESENTATION ), errmsg( "%s", e.to_string().c_str() ) ) );
+    }
+
+    PG_RETURN_POINTER( keys );
+  }
+
+  PG_FUNCTION_INFO_V1(operation_gin_extract_query);
+
+  /// GIN extractQuery, the query of @@ is the one searched key
+  Datum operation_gin_extract_query(PG_FUNCTION_ARGS)
+  {
+    const std::string query_key = gin_query_key( text_to_cstring( PG_GETARG_TEXT_PP( 0 ) ) );
+    auto* nkeys = reinterpret_cast< int32* >( PG_GETARG_POINTER( 1 ) );
+
+    if( query_key.empty() )
+      ereport( ERROR, ( errcode( ERRCODE_INVALID_PARAMETER_VALUE ), errmsg( "Unknown hive.operation query, expected 'account:<name>' or 'type:<id>'" ) ) );
+
+    auto* keys = static_cast< Datum* >( palloc( sizeof( Datum ) ) );
+    keys[ 0 ] = PointerGetDatum( cstring_to_text_with_len( query_key.data(), query_key.size() ) );
+    *nkeys = 1;
+
+    PG_RETURN_POINTER( keys );
+  }
+
+  PG_FUNCTION_INFO_V1(operation_gin_consistent);
+
+  /// GIN consistent, keys are exact so an operation which has the searched key matches without a recheck
+  Datum operation_gin_consistent(PG_FUNCTION_ARGS)
+  {
+    const auto* check = reinterpret_cast< bool* >( PG_GETARG_POINTER( 0 ) );
+    auto* recheck = reinterpret_cast< bool* >( PG_GETARG_POINTER( 5 ) );
+
+    *recheck = false;
+    PG_RETURN_BOOL( check[ 0 ] );
+  }
+
+  PG_FUNCTION_INFO_V1(get_impacted_accounts_in_range);
+
+  /**
+   ** FUNCTION hive.get_impacted_accounts_in_range( _first_block INT, _last_block INT, _operations regclass )
+   **   RETURNS TABLE( operation_id BIGINT, account_name TEXT )
+   ** The same rows as hive.get_impacted_accounts called for each operation of the blocks, but from a single call.
+   */
+  Datum get_impacted_accounts_in_range(PG_FUNCTION_ARGS)
+  {
+    return collect_operations_in_range_and_fill_returned_recordset< flat_set<account_name_type> >( fcinfo, __FUNCTION__, nullptr,
+      [](){},
+      [](int32, const hive::protocol::operation& op, flat_set<account_name_type>& accounts)
+      {
+        accounts.clear();
+        hive::app::operation_get_impacted_accounts( op, accounts );
+      },
+      [] (const auto& account) {fc::string _str = account; return CStringGetTextDatum(_str.c_str());}
+    );
+  }
+
+  PG_FUNCTION_INFO_V1(get_keyauths_in_range_wrapped);
+
+  /**
+   ** FUNCTION hive.get_keyauths_in_range_wrapper( _first_block INT, _last_block INT, _operations regclass )
+   **   RETURNS TABLE( operation_id BIGINT, key_auth TEXT, authority_c_kind INTEGER, account_name TEXT )
+   ** Only operations used in get_keyauths are decoded, like hive.get_keyauths_wrapper it returns C enum as int.
+   */
+  Datum get_keyauths_in_range_wrapped(PG_FUNCTION_ARGS)
+  {
+    return collect_operations_in_range_and_fill_returned_recordset< collected_keyauth_collection_t >( fcinfo, __FUNCTION__, &keyauths_operation_types(),
+      [](){},
+      [](int32, const hive::protocol::operation& op, collected_keyauth_collection_t& keyauths)
+      {
+        keyauths = collect_keyauths(op);
+      },
+      [] (const auto& collected_item) {return CStringGetTextDatum(collected_item.key_auth.c_str());},
+      [] (const auto& collected_item) {return Int32GetDatum(collected_item.authority_kind);},
+      [] (const auto& collected_item) {return CStringGetTextDatum(collected_item.account_name.c_str());}
+    );
+  }
+
+  PG_FUNCTION_INFO_V1(get_impacted_balances_in_range);
+
+  /**
+   ** FUNCTION hive.get_impacted_balances_in_range( _first_block INT, _last_block INT, _operations regclass )
+   **   RETURNS TABLE( operation_id BIGINT, account_name VARCHAR, amount BIGINT, asset_precision INT, asset_symbol_nai INT )
+   ** The same rows as hive.get_impacted_balances( body, block_num ) called for each operation of the blocks, but from a single call.
+   */
+  Datum get_impacted_balances_in_range(PG_FUNCTION_ARGS)
+  {
+    // operations are in HF01 when they are in blocks after the hardfork was applied, as in hive.get_impacted_balances( body, block_num )
+    int32 hf01_block_num = std::numeric_limits< int32 >::max();
+
+    return collect_operations_in_range_and_fill_returned_recordset< impacted_balance_data >( fcinfo, __FUNCTION__, &balance_impacting_operation_types(),
+      [&hf01_block_num]()
+      {
+        if( SPI_execute( "SELECT block_num FROM hive.applied_hardforks WHERE hardfork_num = 1", true, 1 ) != SPI_OK_SELECT )
+          issue_error( fc::string( "get_impacted_balances_in_range: cannot read hive.applied_hardforks" ) );
+
+        bool is_null = false;
+        if( SPI_processed == 1 )
+        {
+          const Datum block_num = SPI_getbinval( SPI_tuptable->vals[ 0 ], SPI_tuptable->tupdesc, 1, &is_null );
+          if( !is_null )
+            hf01_block_num = DatumGetInt32( block_num );
+        }
+        SPI_freetuptable( SPI_tuptable );
+      },
+      [&hf01_block_num](int32 block_num, const hive::protocol::operation& op, impacted_balance_data& balances)
+      {
+        balances = collect_impacted_balances( op, hf01_block_num < block_num );
+      },
+      [] (const auto& impacted_balance) {fc::string account = impacted_balance.first; return CStringGetTextDatum(account.c_str());},
+      [] (const auto& impacted_balance) {const hive::protocol::asset& balance_change = impacted_balance.second; return Int64GetDatum(balance_change.amount.value);},
+      [] (const auto& impacted_balance) {const hive::protocol::asset_symbol_type& token_type = impacted_balance.second.symbol; return Int32GetDatum(int32_t(token_type.decimals()));},
+      [] (const auto& impacted_balance) {const hive::protocol::asset_symbol_type& token_type = impacted_balance.second.symbol; return Int32GetDatum(int32_t(token_type.to_nai()));}
+    );
+  }
+
+  PG_FUNCTION_INFO_V1(update_state_provider_accounts_impl);
+
+  /**
+   ** FUNCTION hive.update_state_provider_accounts_impl( _first_block INT, _last_block INT, _operations regclass, _accounts regclass ) RETURNS void
+   ** Only account_created_operation are read and decoded, names of created accounts are inserted with one INSERT
+   ** in order of their creation, so ids of accounts are given in the same order as before.
+   */
+  Datum update_state_provider_accounts_impl(PG_FUNCTION_ARGS)
+  {
+    const char* C_function_name = __FUNCTION__;
+    const int32 first_block = PG_GETARG_INT32( 0 );
+    const int32 last_block = PG_GETARG_INT32( 1 );
+    const Oid operations = PG_GETARG_OID( 2 );
+    const Oid accounts = PG_GETARG_OID( 3 );
+
+    try
+    {
+      static const std::vector<bool> account_created_types = operation_types_of( { fc::get_typename< hive::protocol::account_created_operation >::name() } );
+
+      std::vector< std::string > names;
+      std::unordered_set< std::string > collected_names;
+
+      if( SPI_connect() != SPI_OK_CONNECT )
+        issue_error( fc::string( C_function_name ) + ": SPI_connect failed" );
+
+      scan_operations_in_range( operations, first_block, last_block, &account_created_types, true,
+        [&]( int64, int32, const hive::protocol::operation& op )
+        {
+          std::string name = get_created_from_account_create_operations_impl( op );
+          if( collected_names.insert( name ).second )
+            names.push_back( std::move( name ) );
+        }
+      );
+
+      if( !names.empty() )
+      {
+        const std::string query = "INSERT INTO " + relation_name_of( accounts ) + "( name )"
+          " SELECT a.name FROM unnest( $1 ) WITH ORDINALITY a( name, position ) ORDER BY a.position"
+          " ON CONFLICT DO NOTHING";
+        Oid argument_types[] = { TEXTARRAYOID };
+        Datum arguments[] = { PointerGetDatum( text_array_of( names ) ) };
+
+        if( SPI_execute_with_args( query.c_str(), 1, argument_types, arguments, nullptr, false, 0 ) != SPI_OK_INSERT )
+          issue_error( fc::string( C_function_name ) + ": cannot insert accounts" );
+      }
+
+      SPI_finish();
+    } HFM_NOEXCEPT_CAPTURE_AND_ISSUE_ERROR( fc::string(" blocks: ") + std::to_string( first_block ) + " - " + std::to_string( last_block ) )
+
+    PG_RETURN_VOID();
+  }
+
+  PG_FUNCTION_INFO_V1(update_state_provider_keyauth_impl);
+
+  /**
+   ** FUNCTION hive.update_state_provider_keyauth_impl( _first_block INT, _last_block INT, _operations regclass, _keyauth regclass ) RETURNS void
+   ** Only operations used in get_keyauths are read and decoded. Keyauths are deduplicated by ( key_auth, authority_kind ) in memory,
+   ** the first one of the blocks is kept as ON CONFLICT DO NOTHING kept it, and all of them are inserted with one INSERT.
+   */
+  Datum update_state_provider_keyauth_impl(PG_FUNCTION_ARGS)
+  {
+    const char* C_function_name = __FUNCTION__;
+    const int32 first_block = PG_GETARG_INT32( 0 );
+    const int32 last_block = PG_GETARG_INT32( 1 );
+    const Oid operations = PG_GETARG_OID( 2 );
+    const Oid keyauth = PG_GETARG_OID( 3 );
+
+    try
+    {
+      std::vector< std::string > key_auths;
+      std::vector< Datum > authority_kinds;
+      std::vector< std::string > account_names;
+      std::set< std::pair< std::string, int32 > > collected_keyauths;
+
+      if( SPI_connect() != SPI_OK_CONNECT )
+        issue_error( fc::string( C_function_name ) + ": SPI_connect failed" );
+
+      scan_operations_in_range( operations, first_block, last_block, &keyauths_operation_types(), true,
+        [&]( int64, int32, const hive::protocol::operation& op )
+        {
+          for( const auto& collected_item : collect_keyauths( op ) )
+          {
+            const auto authority_kind = static_cast< int32 >( collected_item.authority_kind );
+            if( !collected_keyauths.emplace( collected_item.key_auth, authority_kind ).second )
+              continue;
+
+            key_auths.push_back( collected_item.key_auth );
+            authority_kinds.push_back( Int32GetDatum( authority_kind ) );
+            account_names.push_back( collected_item.account_name );
+          }
+        }
+      );
+
+      if( !key_auths.empty() )
+      {
+        const std::string query = "INSERT INTO " + relation_name_of( keyauth ) +
+          " SELECT k.key_auth, ( enum_range( NULL::hive.authority_type ) )[ k.authority_c_kind + 1 ], k.account_name"
+          " FROM unnest( $1, $2, $3 ) k( key_auth, authority_c_kind, account_name )"
+          " ON CONFLICT DO NOTHING";
+        Oid argument_types[] = { TEXTARRAYOID, INT4ARRAYOID, TEXTARRAYOID };
+        Datum arguments[] = {
+            PointerGetDatum( text_array_of( key_auths ) )
+          , PointerGetDatum( construct_array( authority_kinds.data(), authority_kinds.size(), INT4OID, sizeof( int32 ), true, 'i' ) )
+          , PointerGetDatum( text_array_of( account_names ) )
+        };
+
+        if( SPI_execute_with_args( query.c_str(), 3, argument_types, arguments, nullptr, false, 0 ) != SPI_OK_INSERT )
+          issue_error( fc::string( C_function_name ) + ": cannot insert keyauths" );
+      }
+
+      SPI_finish();
+    } HFM_NOEXCEPT_CAPTURE_AND_ISSUE_ERROR( fc::string(" blocks: ") + std::to_string( first_block ) + " - " + std::to_string( last_block ) )
+
+    PG_RETURN_VOID();
+  }
 }
@@ -35,7 +35,12 @@ $BODY$
 
 CREATE OR REPLACE FUNCTION hive.get_created_from_account_create_operations(IN _account_operation hive.operation)
 RETURNS TEXT
-AS 'MODULE_PATHNAME', 'get_created_from_account_create_operations' LANGUAGE C;
+AS 'MODULE_PATHNAME', 'get_created_from_account_create_operations' LANGUAGE C IMMUTABLE PARALLEL SAFE;
+
+-- reads account_created_operation of the blocks from _operations and inserts names of created accounts into _accounts with one INSERT
+CREATE OR REPLACE FUNCTION hive.update_state_provider_accounts_impl( _first_block INT, _last_block INT, _operations regclass, _accounts regclass )
+RETURNS void
+AS 'MODULE_PATHNAME', 'update_state_provider_accounts_impl' LANGUAGE C VOLATILE;
 
 CREATE OR REPLACE FUNCTION hive.update_state_provider_accounts( _first_block hive.blocks.num%TYPE, _last_block hive.blocks.num%TYPE, _context hive.context_name )
     RETURNS void
@@ -56,16 +61,11 @@ BEGIN
              RAISE EXCEPTION 'No context with name %', _context;
     END IF;
 
-    EXECUTE format(
-        'INSERT INTO hive.%s_accounts( name )
-        SELECT hive.get_created_from_account_create_operations( ov.body ) as name
-        FROM hive.%s_operations_view ov
-        JOIN hive.operation_types ot ON ov.op_type_id = ot.id
-        WHERE
-            ARRAY[ lower( ot.name ) ] <@ ARRAY[ ''hive::protocol::account_created_operation'' ]
-            AND ov.block_num BETWEEN %s AND %s
-        ON CONFLICT DO NOTHING'
-        , _context, _context, _first_block, _last_block
+    PERFORM hive.update_state_provider_accounts_impl(
+          _first_block
+        , _last_block
+        , format( 'hive.%I', _context || '_operations_view' )::regclass
+        , format( 'hive.%I', __table_name )::regclass
     );
 END;
 $BODY$
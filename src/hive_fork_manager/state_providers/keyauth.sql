@@ -52,6 +52,11 @@ END;
 $BODY$
 ;
 
+-- reads operations used in get_keyauths of the blocks from _operations and inserts their keyauths into _keyauth with one INSERT
+CREATE OR REPLACE FUNCTION hive.update_state_provider_keyauth_impl( _first_block INT, _last_block INT, _operations regclass, _keyauth regclass )
+RETURNS void
+AS 'MODULE_PATHNAME', 'update_state_provider_keyauth_impl' LANGUAGE C VOLATILE;
+
 CREATE OR REPLACE FUNCTION hive.update_state_provider_keyauth(
     _first_block hive.blocks.num%TYPE,
     _last_block hive.blocks.num%TYPE,
@@ -74,16 +79,11 @@ BEGIN
              RAISE EXCEPTION 'No context with name %', _context;
     END IF;
 
-    EXECUTE format(
-        'INSERT INTO hive.%s_keyauth 
-        SELECT (hive.get_keyauths( ov.body )).*
-        FROM hive.%s_operations_view ov
-        WHERE
-                hive.is_keyauths_operation(ov.body)
-            AND 
-                ov.block_num BETWEEN %s AND %s
-        ON CONFLICT DO NOTHING'
-        , _context, _context, _first_block, _last_block
+    PERFORM hive.update_state_provider_keyauth_impl(
+          _first_block
+        , _last_block
+        , format( 'hive.%I', _context || '_operations_view' )::regclass
+        , format( 'hive.%I', __table_name )::regclass
     );
 END;
 $BODY$
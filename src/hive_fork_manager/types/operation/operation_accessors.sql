@@ -0,0 +1,18 @@
+-- Accessors which read the raw hive.operation data without unpacking the whole operation.
+-- They are immutable, so they can be used in expression indexes.
+
+-- id of the operation type, the same as hive.operations.op_type_id
+CREATE OR REPLACE FUNCTION hive.operation_type_id(
+  hive.operation
+) RETURNS smallint LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_type_id';
+
+-- text of a member of the operation, NULL when the operation has no such member or it is an empty optional
+-- strings are not quoted, other members are compact JSON, so their text may differ from jsonb text in whitespace
+-- members are unpacked only up to the requested one
+CREATE OR REPLACE FUNCTION hive.operation_field_text(
+  hive.operation, _field TEXT
+) RETURNS TEXT LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_field_text';
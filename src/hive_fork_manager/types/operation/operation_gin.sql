@@ -0,0 +1,46 @@
+-- GIN index of hive.operation, keys of an operation are the accounts impacted by it (as hive.get_impacted_accounts returns them)
+-- and its type. Such index serves queries:
+--   body @@ 'account:<name>' - the operation impacts the account
+--   body @@ 'type:<id>'      - the operation has the type, the same as hive.operations.op_type_id
+-- e.g. CREATE INDEX operations_accounts_idx ON hive.operations USING gin( body );
+
+CREATE OR REPLACE FUNCTION hive._operation_matches(
+  hive.operation, TEXT
+) RETURNS bool LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_matches';
+
+CREATE OPERATOR @@ (
+    LEFTARG    = hive.operation,
+    RIGHTARG   = TEXT,
+    PROCEDURE  = hive._operation_matches,
+    RESTRICT = contsel,
+    JOIN = contjoinsel
+);
+
+CREATE OR REPLACE FUNCTION hive._operation_gin_extract_value(
+  hive.operation, internal, internal
+) RETURNS internal LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_gin_extract_value';
+
+CREATE OR REPLACE FUNCTION hive._operation_gin_extract_query(
+  TEXT, internal, int2, internal, internal, internal, internal
+) RETURNS internal LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_gin_extract_query';
+
+CREATE OR REPLACE FUNCTION hive._operation_gin_consistent(
+  internal, int2, TEXT, int4, internal, internal, internal, internal
+) RETURNS bool LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE
+AS 'MODULE_PATHNAME',
+'operation_gin_consistent';
+
+CREATE OPERATOR CLASS hive.operation_gin_ops
+DEFAULT FOR TYPE hive.operation USING gin AS
+    OPERATOR    1   @@ (hive.operation, TEXT),
+    FUNCTION    1   bttextcmp(TEXT, TEXT),
+    FUNCTION    2   hive._operation_gin_extract_value(hive.operation, internal, internal),
+    FUNCTION    3   hive._operation_gin_extract_query(TEXT, internal, int2, internal, internal, internal, internal),
+    FUNCTION    4   hive._operation_gin_consistent(internal, int2, TEXT, int4, internal, internal, internal, internal),
+STORAGE TEXT;
@@ -4,7 +4,7 @@
 
 namespace hive{ namespace plugins{ namespace sql_serializer {
 
-  void accounts_collector::collect(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num)
+  void accounts_collector::collect(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num, const flat_set<hive::protocol::account_name_type>* impacted)
   {
     _processed_operation_id = operation_id;
     
@@ -13,10 +13,16 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
 
     _processed_operation_type_id = static_cast<int32_t>(op.which());
     _block_num = block_num;
-    _impacted.clear();
-    hive::app::operation_get_impacted_accounts(op, _impacted);
+    if( impacted != nullptr )
+      _current_impacted = impacted;
+    else
+    {
+      _impacted.clear();
+      hive::app::operation_get_impacted_accounts(op, _impacted);
+      _current_impacted = &_impacted;
+    }
 
-    on_collect( op, _impacted );
+    on_collect( op, *_current_impacted );
 
     op.visit(*this);
   }
@@ -97,29 +103,61 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
     _cached_data.accounts.emplace_back(account_id, std::string(account_name), _block_num);
   }
 
-  void accounts_collector::on_new_operation(const hive::protocol::account_name_type& account_name, int64_t operation_id, int32_t operation_type_id, bool is_current_operation)
+  accounts_collector::account_cache_entry* accounts_collector::find_cached_account(const hive::protocol::account_name_type& account_name)
   {
-    bool _allow_add_operation = on_before_new_operation( account_name, is_current_operation );
+    auto found = _accounts_cache.find(account_name);
+    if( found != _accounts_cache.end() )
+      return &found->second;
 
     const hive::chain::account_object* account_ptr = _chain_db.find_account(account_name);
 
     if( account_ptr == nullptr )
-      return;
+      return nullptr;
 
     account_ops_seq_object::id_type account_id(account_ptr->get_id());
 
     const account_ops_seq_object* op_seq_obj = _chain_db.find< account_ops_seq_object, hive::chain::by_id >( account_id );
 
     if( op_seq_obj == nullptr )
+      return nullptr;
+
+    return &_accounts_cache.emplace( account_name, account_cache_entry{ account_id, op_seq_obj } ).first->second;
+  }
+
+  void accounts_collector::on_new_operation(const hive::protocol::account_name_type& account_name, int64_t operation_id, int32_t operation_type_id, bool is_current_operation)
+  {
+    bool _allow_add_operation = on_before_new_operation( account_name, is_current_operation );
+
+    account_cache_entry* account = find_cached_account(account_name);
+
+    if( account == nullptr )
       return;
 
     if( _psql_dump_account_operations && _allow_add_operation )
-      _cached_data.account_operations.emplace_back(_block_num, operation_id, account_id, op_seq_obj->operation_count, operation_type_id);
+      _cached_data.account_operations.emplace_back(_block_num, operation_id, account->account_id, account->op_seq_obj->operation_count + account->new_operations, operation_type_id);
+
+    ++account->new_operations;
+  }
+
+  void accounts_collector::on_block_begin()
+  {
+    _accounts_cache.clear();
+  }
 
-    _chain_db.modify( *op_seq_obj, [&]( account_ops_seq_object& o)
+  void accounts_collector::on_block_end()
+  {
+    for( const auto& account : _accounts_cache )
     {
-      o.operation_count++;
-    } );
+      if( account.second.new_operations == 0 )
+        continue;
+
+      _chain_db.modify( *account.second.op_seq_obj, [&]( account_ops_seq_object& o)
+      {
+        o.operation_count += account.second.new_operations;
+      } );
+    }
+
+    _accounts_cache.clear();
   }
 
   filtered_accounts_collector::filtered_accounts_collector( hive::chain::database& chain_db , cached_data_t& cached_data, bool psql_dump_account_operations, const blockchain_data_filter& filter )
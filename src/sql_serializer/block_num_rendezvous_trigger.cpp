@@ -1,4 +1,6 @@
 #include "hive/plugins/sql_serializer/block_num_rendezvous_trigger.hpp"
+#include "hive/plugins/sql_serializer/flush_tracer.hpp"
+#include "hive/plugins/sql_serializer/serializer_metrics.hpp"
 
 #include "fc/exception/exception.hpp"
 
@@ -30,11 +32,20 @@ namespace hive { namespace plugins { namespace sql_serializer {
     auto stage_it = m_completed_threads.find( _stage_block_num );
     if ( stage_it == m_completed_threads.end() ) {
       m_completed_threads.emplace( _stage_block_num, 1 );
+      m_first_report_time.emplace( _stage_block_num, fc::time_point::now() );
       return;
     }
 
     if ( ( stage_it->second + 1 ) == m_number_of_threads ) {
       m_completed_threads.erase( stage_it );
+      // how long the fastest thread waited for the slowest one
+      auto first_report_it = m_first_report_time.find( _stage_block_num );
+      if ( first_report_it != m_first_report_time.end() ) {
+        const auto now = fc::time_point::now();
+        tracer().record( "rendezvous", nullptr, _stage_block_num, first_report_it->second, now );
+        metrics().rendezvous_wait_us.observe( ( now - first_report_it->second ).count() );
+        m_first_report_time.erase( first_report_it );
+      }
       m_triggered_function( _stage_block_num );
 
       ilog( "Dump whole block ${i}", ("i", _stage_block_num) );
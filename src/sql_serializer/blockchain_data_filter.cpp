@@ -9,18 +9,25 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
 
   bool blockchain_filter::is_trx_accepted( int64_t trx_in_block ) const
   {
-    return !is_enabled() || trx_in_block_filter_accepted.find( trx_in_block ) != trx_in_block_filter_accepted.end();
+    return !is_enabled() || trx_in_block_filter_accepted.contains( trx_in_block );
   }
 
   bool blockchain_filter::is_tracked_account( const account_name_type& name ) const
   {
-    return !accounts_filter_tracker || accounts_filter_tracker->is_tracked_account( name );
+    return accounts_filter.empty() || accounts_filter.contains( name );
   }
 
   bool blockchain_filter::is_tracked_operation( const operation& op ) const
   {
-    return ( !operations_filter_tracker       ||  operations_filter_tracker->is_tracked_operation( op ) ) &&
-           ( !operations_body_filter_tracker  ||  operations_body_filter_tracker->is_tracked_operation( op ) );
+    if( track_operations && !operations_filter.contains( op.which() ) )
+      return false;
+
+    if( operations_predicates.empty() && !operations_body_filter_tracker )
+      return true;
+
+    //An operation accepted by a predicate doesn't need to be converted to JSON for regexes.
+    return operations_predicates.is_tracked_operation( op ) ||
+           ( operations_body_filter_tracker && operations_body_filter_tracker->is_tracked_operation( op ) );
   }
 
   void blockchain_filter::remember_trx_id( int64_t trx_in_block )
@@ -33,26 +40,28 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
   void blockchain_filter::fill( const boost::program_options::variables_map& options,
                                         const std::string& tracked_accounts,
                                         const std::string& tracked_operations,
-                                        const std::string& tracked_body_operations )
+                                        const std::string& tracked_body_operations,
+                                        const std::string& tracked_operation_predicates )
   {
     if( is_enabled() )
     {
-      ptr_account_tracker         _af   = ptr_account_tracker( new account_filter("acc-sql") );
-      ptr_operations_tracker      _of   = ptr_operations_tracker( new operation_filter( "op-sql", op_helper ) );
+      operation_filter            _of( "op-sql", op_helper );
       ptr_operations_body_tracker _obf  = ptr_operations_body_tracker( new operation_body_filter( "opb-sql", op_helper ) );
 
-      _af->fill( options, tracked_accounts );
-      _of->fill( options, tracked_operations );
+      accounts_filter.fill( options, tracked_accounts );
+      _of.fill( options, tracked_operations );
       _obf->fill( options, tracked_body_operations );
+      operations_predicates.fill( options, tracked_operation_predicates );
 
-      if( _af->empty() && _of->empty() && _obf->empty() )
+      if( accounts_filter.empty() && _of.empty() && _obf->empty() && operations_predicates.empty() )
         enabled = false;
 
-      if( !_af->empty() )
-        accounts_filter_tracker = std::move( _af );
-
-      if( !_of->empty() )
-        operations_filter_tracker = std::move( _of );
+      if( !_of.empty() )
+      {
+        //Names of operations are resolved by `operation_filter` once, here.
+        operations_filter.compile( [&_of]( const operation& op ){ return _of.is_tracked_operation( op ); } );
+        track_operations = true;
+      }
 
       if( !_obf->empty() )
         operations_body_filter_tracker = std::move( _obf );
@@ -0,0 +1,71 @@
+#include <hive/plugins/sql_serializer/compiled_filter.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  void operation_types_set::compile( const std::function<bool( const operation& )>& is_tracked_operation )
+  {
+    _accepted.assign( operation::count(), false );
+
+    operation _op;
+    for( int32_t _type_id = 0; _type_id < operation::count(); ++_type_id )
+    {
+      _op.set_which( _type_id );
+      _accepted[ _type_id ] = is_tracked_operation( _op );
+    }
+  }
+
+  void account_ranges::fill( const boost::program_options::variables_map& options, const std::string& option_name )
+  {
+    _ranges.clear();
+
+    if( !options.count( option_name ) )
+      return;
+
+    for( const std::string& _range : options[ option_name ].as<std::vector<std::string>>() )
+    {
+      auto _pair = fc::json::from_string( _range ).as<range_t>();
+      FC_ASSERT( _pair.first <= _pair.second, "Invalid range of accounts ${r}: the first account is greater than the second one", ("r", _range) );
+      _ranges.emplace_back( std::move( _pair ) );
+    }
+
+    std::sort( _ranges.begin(), _ranges.end() );
+
+    std::vector<range_t> _merged;
+    for( const auto& _range : _ranges )
+    {
+      if( !_merged.empty() && _range.first <= _merged.back().second )
+        _merged.back().second = std::max( _merged.back().second, _range.second );
+      else
+        _merged.push_back( _range );
+    }
+    _ranges = std::move( _merged );
+  }
+
+  bool account_ranges::contains( const account_name_type& name ) const
+  {
+    //The first range which starts after the name, so only the previous one can contain it.
+    auto _found = std::upper_bound( _ranges.begin(), _ranges.end(), name,
+      []( const account_name_type& name, const range_t& range ){ return name < range.first; } );
+
+    if( _found == _ranges.begin() )
+      return false;
+
+    return name <= std::prev( _found )->second;
+  }
+
+  void transactions_bitmap::insert( int64_t trx_in_block )
+  {
+    FC_ASSERT( trx_in_block >= 0 );
+
+    if( static_cast<uint64_t>( trx_in_block ) >= _accepted.size() )
+      _accepted.resize( trx_in_block + 1, false );
+    _accepted[ trx_in_block ] = true;
+  }
+
+}}} // namespace hive::plugins::sql_serializer
@@ -1,4 +1,6 @@
 #include <hive/plugins/sql_serializer/data_processor.hpp>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
 
 #include <fc/exception/exception.hpp>
 #include <fc/log/logger.hpp>
@@ -56,6 +58,7 @@ data_processor::data_processor( std::string description, const data_processing_f
     ilog("Entering data processor thread: ${d}", ("d", _description));
     fc::set_thread_name("sql_serializer");
     fc::thread::current().set_name("sql_serializer");
+    tracer().set_thread_name(_description);
 
     try
     {
@@ -93,6 +96,7 @@ data_processor::data_processor( std::string description, const data_processing_f
 
         {
           data_processing_status_notifier notifier(&_is_processing_data, &_data_processing_mtx, &_data_processing_finished_cv);
+          trace_span processing_span("process", last_block_num_in_stage);
 
           dataProcessor(*dataPtr);
 
@@ -140,6 +144,8 @@ void data_processor::trigger(data_chunk_ptr dataPtr, uint32_t last_blocknum)
   /// wait for the worker
   {
     dlog("Waiting until data_processor ${d} will consume a data...", ("d", _description));
+    trace_span queue_wait_span( "queue wait", last_blocknum );
+    metrics_timer queue_wait_timer( metrics().queue_wait_us );
     std::unique_lock<std::mutex> lk(_mtx);
     _cv.wait(lk, [this] {return _dataPtr.valid() == false; });
   }
@@ -1,5 +1,6 @@
 #include "hive/plugins/sql_serializer/end_massive_sync_processor.hpp"
 
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
 #include <hive/plugins/sql_serializer/queries_commit_data_processor.h>
 
 #include <cassert>
@@ -14,6 +15,7 @@ namespace sql_serializer {
     end_massive_sync_processor::end_massive_sync_processor( std::string psqlUrl )
     {
       auto commiting_function = [this](const data_processor::data_chunk_ptr&, transaction_controllers::transaction& tx) -> data_processor::data_processing_status {
+        trace_span end_massive_sync_span( "end_massive_sync", _block_number );
         tx.exec( "SELECT hive.end_massive_sync("s + std::to_string( _block_number ) + ")"s );
 
         return data_processor::data_processing_status();
@@ -0,0 +1,123 @@
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+
+#include <fstream>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  namespace {
+    std::string escape_json( const std::string& text ) {
+      std::string result;
+      for ( auto character : text ) {
+        if ( character == '"' || character == '\\' )
+          result += '\\';
+        if ( static_cast< unsigned char >( character ) >= 0x20 )
+          result += character;
+      }
+      return result;
+    }
+  } // namespace
+
+  void flush_tracer::enable( uint32_t capacity ) {
+    FC_ASSERT( !is_enabled(), "Tracer is already enabled" );
+    FC_ASSERT( capacity > 0, "Tracer needs a non empty buffer" );
+
+    _events = std::make_unique< event[] >( capacity );
+    _capacity = capacity;
+    _enabled.store( true );
+    ilog( "sql_serializer flush tracing is enabled, last ${c} spans are kept", ("c", capacity) );
+  }
+
+  uint32_t flush_tracer::current_thread_id() {
+    static std::atomic< uint32_t > next_thread_id{ 1 };
+    thread_local const uint32_t thread_id = next_thread_id++;
+    return thread_id;
+  }
+
+  void flush_tracer::record( const char* name, const char* table, uint32_t block_num, fc::time_point start, fc::time_point end ) {
+    if ( !is_enabled() )
+      return;
+
+    const auto index = _next_event.fetch_add( 1, std::memory_order_relaxed );
+    auto& slot = _events[ index % _capacity ];
+    // the slot is marked as being written, so dump() skips it until it is consistent again
+    slot.sequence.store( 0, std::memory_order_relaxed );
+    // the fields below cannot become visible before the slot is marked
+    std::atomic_thread_fence( std::memory_order_release );
+    slot.name.store( name, std::memory_order_relaxed );
+    slot.table.store( table, std::memory_order_relaxed );
+    slot.block_num.store( block_num, std::memory_order_relaxed );
+    slot.thread_id.store( current_thread_id(), std::memory_order_relaxed );
+    slot.start_us.store( start.time_since_epoch().count(), std::memory_order_relaxed );
+    slot.duration_us.store( ( end - start ).count(), std::memory_order_relaxed );
+    slot.sequence.store( index + 1, std::memory_order_release );
+  }
+
+  void flush_tracer::set_thread_name( const std::string& name ) {
+    std::lock_guard< std::mutex > lock( _thread_names_mutex );
+    _thread_names[ current_thread_id() ] = name;
+  }
+
+  void flush_tracer::dump( const std::string& file_path ) const {
+    if ( !is_enabled() ) {
+      wlog( "sql_serializer flush tracing is disabled, nothing to dump" );
+      return;
+    }
+
+    std::ofstream file( file_path, std::ios::trunc );
+    if ( !file ) {
+      wlog( "Cannot write sql_serializer trace to ${f}", ("f", file_path) );
+      return;
+    }
+
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&first]() { const char* result = first ? "" : ",\n"; first = false; return result; };
+
+    {
+      std::lock_guard< std::mutex > lock( _thread_names_mutex );
+      for ( const auto& thread : _thread_names ) {
+        file << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+             << ",\"args\":{\"name\":\"" << escape_json( thread.second ) << "\"}}";
+      }
+    }
+
+    uint32_t dumped_events = 0;
+    const auto last_event = _next_event.load( std::memory_order_acquire );
+    const auto first_event = last_event > _capacity ? last_event - _capacity : 0;
+    for ( auto index = first_event; index < last_event; ++index ) {
+      const auto& slot = _events[ index % _capacity ];
+      if ( slot.sequence.load( std::memory_order_acquire ) != index + 1 )
+        continue;
+
+      const char* name = slot.name.load( std::memory_order_relaxed );
+      const char* table = slot.table.load( std::memory_order_relaxed );
+      const auto block_num = slot.block_num.load( std::memory_order_relaxed );
+      const auto thread_id = slot.thread_id.load( std::memory_order_relaxed );
+      const auto start_us = slot.start_us.load( std::memory_order_relaxed );
+      const auto duration_us = slot.duration_us.load( std::memory_order_relaxed );
+      // the reads above cannot be moved after the check of the sequence
+      std::atomic_thread_fence( std::memory_order_acquire );
+      if ( slot.sequence.load( std::memory_order_relaxed ) != index + 1 )
+        continue; // overwritten while it was read
+
+      file << separator() << "{\"name\":\"" << name << "\",\"cat\":\"sql_serializer\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id
+           << ",\"ts\":" << start_us << ",\"dur\":" << duration_us << ",\"args\":{\"block\":" << block_num;
+      if ( table )
+        file << ",\"table\":\"" << table << "\"";
+      file << "}}";
+      ++dumped_events;
+    }
+
+    file << "\n]}\n";
+    ilog( "Dumped ${n} sql_serializer trace events to ${f}", ("n", dumped_events)("f", file_path) );
+  }
+
+  flush_tracer& tracer() {
+    static flush_tracer instance;
+    return instance;
+  }
+
+}}} // namespace hive::plugins::sql_serializer
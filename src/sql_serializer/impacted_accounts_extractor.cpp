@@ -0,0 +1,120 @@
+#include <hive/plugins/sql_serializer/impacted_accounts_extractor.hpp>
+
+#include <hive/chain/util/impacted.hpp>
+
+#include <fc/exception/exception.hpp>
+
+#include <algorithm>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  impacted_accounts_extractor::impacted_accounts_extractor( uint32_t threads_number )
+  {
+    FC_ASSERT( threads_number > 0 );
+
+    for( uint32_t i = 0; i < threads_number; ++i )
+      _workers.emplace_back( [this]{ work(); } );
+  }
+
+  impacted_accounts_extractor::~impacted_accounts_extractor()
+  {
+    finish_block();
+
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _stop = true;
+    }
+    _cv.notify_all();
+
+    for( auto& worker : _workers )
+      worker.join();
+  }
+
+  void impacted_accounts_extractor::start_block( const std::shared_ptr<hive::chain::full_block_type>& block )
+  {
+    //a previous block could fail in the middle of its application
+    finish_block();
+
+    _block = block;
+    for( const auto& trx : _block->get_full_transactions() )
+    {
+      _transaction_offsets.push_back( _operations.size() );
+      for( const auto& op : trx->get_transaction().operations )
+        _operations.push_back( &op );
+    }
+
+    _impacted.resize( _operations.size() );
+
+    {
+      std::lock_guard<std::mutex> lock( _mutex );
+      for( size_t begin = 0; begin < _operations.size(); begin += chunk_size )
+      {
+        auto& new_chunk = _chunks.emplace_back();
+        new_chunk.begin = begin;
+        new_chunk.end = std::min( begin + chunk_size, _operations.size() );
+        new_chunk.ready = new_chunk.done.get_future().share();
+        _queue.push_back( &new_chunk );
+      }
+    }
+    _cv.notify_all();
+  }
+
+  const impacted_accounts_extractor::impacted_t* impacted_accounts_extractor::get( int64_t trx_in_block, uint32_t op_in_trx )
+  {
+    if( trx_in_block < 0 || static_cast<size_t>( trx_in_block ) >= _transaction_offsets.size() )
+      return nullptr;
+
+    const size_t index = _transaction_offsets[ trx_in_block ] + op_in_trx;
+    const size_t trx_end = static_cast<size_t>( trx_in_block ) + 1 < _transaction_offsets.size() ? _transaction_offsets[ trx_in_block + 1 ] : _operations.size();
+    if( index >= trx_end )
+      return nullptr;
+
+    //rethrows an exception from a worker
+    _chunks[ index / chunk_size ].ready.get();
+
+    return &_impacted[ index ];
+  }
+
+  void impacted_accounts_extractor::finish_block()
+  {
+    for( auto& processed_chunk : _chunks )
+      processed_chunk.ready.wait();
+
+    _chunks.clear();
+    _operations.clear();
+    _transaction_offsets.clear();
+    _block.reset();
+  }
+
+  void impacted_accounts_extractor::work()
+  {
+    while( true )
+    {
+      chunk* next_chunk = nullptr;
+      {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _cv.wait( lock, [this]{ return _stop || !_queue.empty(); } );
+        if( _stop )
+          return;
+
+        next_chunk = _queue.front();
+        _queue.pop_front();
+      }
+
+      try
+      {
+        for( size_t i = next_chunk->begin; i < next_chunk->end; ++i )
+        {
+          _impacted[ i ].clear();
+          hive::app::operation_get_impacted_accounts( *_operations[ i ], _impacted[ i ] );
+        }
+        next_chunk->done.set_value();
+      }
+      catch( ... )
+      {
+        next_chunk->done.set_exception( std::current_exception() );
+      }
+    }
+  }
+
+}}} // namespace hive::plugins::sql_serializer
@@ -32,7 +32,13 @@ namespace hive::plugins::sql_serializer {
 
     virtual ~accounts_collector(){}
 
-    void collect(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num);
+    /// when `impacted` is not given, accounts impacted by the operation are found here
+    void collect(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num, const flat_set<hive::protocol::account_name_type>* impacted = nullptr);
+
+    /// Forgets accounts cached during a block whose application failed
+    void on_block_begin();
+    /// Writes numbers of operations of accounts impacted in the block to chainbase, it must be done inside of the block's undo session
+    void on_block_end();
 
     void operator()(const hive::protocol::account_create_operation& op);
 
@@ -49,7 +55,7 @@ namespace hive::plugins::sql_serializer {
     template< typename T >
     void operator()(const T& op)
     {
-      for( const auto& account_name : _impacted )
+      for( const auto& account_name : *_current_impacted )
         on_new_operation(account_name, _processed_operation_id, _processed_operation_type_id);
     }
 
@@ -60,6 +66,15 @@ namespace hive::plugins::sql_serializer {
 
       void on_new_operation(const hive::protocol::account_name_type& account_name, int64_t operation_id, int32_t operation_type_id, bool is_current_operation = true);
 
+      struct account_cache_entry
+      {
+        account_ops_seq_object::id_type account_id;
+        const account_ops_seq_object*   op_seq_obj = nullptr;
+        uint32_t                        new_operations = 0;
+      };
+
+      account_cache_entry* find_cached_account(const hive::protocol::account_name_type& account_name);
+
     private:
       hive::chain::database& _chain_db;
       cached_data_t& _cached_data;
@@ -72,7 +87,15 @@ namespace hive::plugins::sql_serializer {
       fc::optional<int64_t> _creation_operation_id;
 
       flat_set<hive::protocol::account_name_type> _impacted;
+      const flat_set<hive::protocol::account_name_type>* _current_impacted = &_impacted;
       bool _psql_dump_account_operations;
+
+      /*
+        Hot accounts (exchanges, popular dApps) are impacted by thousands of operations in a block. Their ids and
+        counters of operations are looked up in chainbase once per block, and counters are modified once per block.
+        Accounts which don't have a counter yet are not cached, they can get it later in the same block.
+      */
+      std::map<hive::protocol::account_name_type, account_cache_entry> _accounts_cache;
     };
 
     struct filtered_accounts_collector: public accounts_collector
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <fc/time.hpp>
+
 #include <functional>
 #include <mutex>
 #include <unordered_map>
@@ -32,6 +34,7 @@ private:
   const NUMBER_OF_COMPLETED_THREADS m_number_of_threads;
   TRIGGERRED_FUNCTION m_triggered_function;
   std::unordered_map< BLOCK_NUM, NUMBER_OF_COMPLETED_THREADS > m_completed_threads;
+  std::unordered_map< BLOCK_NUM, fc::time_point > m_first_report_time;
   std::mutex m_mutex;
 };
 
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <hive/chain/util/data_filter.hpp>
-#include<set>
+#include <hive/plugins/sql_serializer/compiled_filter.hpp>
+#include <hive/plugins/sql_serializer/operation_predicates.hpp>
 
 namespace hive::plugins::sql_serializer {
 
-  using hive::plugins::account_filter;
   using hive::protocol::account_name_type;
 
   struct blockchain_data_filter
@@ -22,18 +22,23 @@ namespace hive::plugins::sql_serializer {
       template<typename filter_type>
       using ptr_proxy_tracker           = std::unique_ptr<filter_type>;
 
-      using ptr_account_tracker         = ptr_proxy_tracker<account_filter>;
-      using ptr_operations_tracker      = ptr_proxy_tracker<operation_filter>;
       using ptr_operations_body_tracker = ptr_proxy_tracker<operation_body_filter>;
 
       bool                  enabled = false;
 
-      std::set<int64_t>     trx_in_block_filter_accepted;
+      transactions_bitmap   trx_in_block_filter_accepted;
 
       operation_helper      op_helper;
 
-      ptr_account_tracker         accounts_filter_tracker;
-      ptr_operations_tracker      operations_filter_tracker;
+      /*
+        Filters of accounts and operations' types are compiled: they are checked for every operation
+        and every impacted account, so a lookup in them must be cheap. Only a body filter needs the operation itself:
+        predicates on fields are checked first, regexes on a JSON form of the operation are the fallback.
+      */
+      account_ranges              accounts_filter;
+      operation_types_set         operations_filter;
+      bool                        track_operations = false;
+      operation_predicates        operations_predicates;
       ptr_operations_body_tracker operations_body_filter_tracker;
 
     public:
@@ -52,7 +57,8 @@ namespace hive::plugins::sql_serializer {
       void fill(  const boost::program_options::variables_map& options,
                   const std::string& tracked_accounts,
                   const std::string& tracked_operations,
-                  const std::string& tracked_operation_body_filters );
+                  const std::string& tracked_operation_body_filters,
+                  const std::string& tracked_operation_predicates );
       void clear();
   };
 
@@ -43,4 +43,7 @@ namespace hive::plugins::sql_serializer {
     };
 
   using cached_containter_t = std::unique_ptr<cached_data_t>;
+
+  // moves out data of blocks <= irreversible_block, nothing is moved for indexation_state::NO_IRREVERSIBLE_BLOCK
+  cached_data_t move_irreveresible_blocks( cached_data_t& cached_data, uint32_t irreversible_block );
 } //namespace hive::plugins::sql_serializer
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <hive/protocol/operations.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hive::plugins::sql_serializer {
+
+  using hive::protocol::account_name_type;
+  using hive::protocol::operation;
+
+  /**
+   * Operation types accepted by a filter, indexed by `operation::which()`.
+   * A type filter does not look at bodies of operations, so it is compiled once by asking it about
+   * a default instance of each type, then the check of an operation is a single bit test.
+   */
+  class operation_types_set
+  {
+    private:
+
+      std::vector<bool> _accepted;
+
+    public:
+
+      void compile( const std::function<bool( const operation& )>& is_tracked_operation );
+
+      bool contains( int32_t type_id ) const
+      {
+        return type_id >= 0 && static_cast<size_t>( type_id ) < _accepted.size() && _accepted[ type_id ];
+      }
+  };
+
+  /**
+   * Ranges of tracked accounts from `psql-track-account-range` options, sorted and merged into disjoint
+   * [from, to] intervals, so an account is found with a binary search regardless of how ranges overlap.
+   */
+  class account_ranges
+  {
+    private:
+
+      using range_t = std::pair<account_name_type, account_name_type>;
+
+      std::vector<range_t> _ranges;
+
+    public:
+
+      void fill( const boost::program_options::variables_map& options, const std::string& option_name );
+
+      bool empty() const { return _ranges.empty(); }
+      bool contains( const account_name_type& name ) const;
+  };
+
+  /**
+   * Transactions of the current block which contain accepted operations, indexed by `trx_in_block`.
+   * Clearing keeps the allocated storage, so after the first blocks nothing is allocated per block.
+   */
+  class transactions_bitmap
+  {
+    private:
+
+      std::vector<bool> _accepted;
+
+    public:
+
+      void insert( int64_t trx_in_block );
+      bool contains( int64_t trx_in_block ) const
+      {
+        return trx_in_block >= 0 && static_cast<uint64_t>( trx_in_block ) < _accepted.size() && _accepted[ trx_in_block ];
+      }
+      void clear() { _accepted.clear(); }
+  };
+
+} // namespace hive::plugins::sql_serializer
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <hive/plugins/sql_serializer/block_num_rendezvous_trigger.hpp>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
 #include <hive/plugins/sql_serializer/queries_commit_data_processor.h>
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
 
 #include <fc/exception/exception.hpp>
 
@@ -56,10 +58,11 @@ namespace hive::plugins::sql_serializer {
         class chunk : public data_processor::data_chunk
           {
           public:
-            chunk( DataContainer&& data ) : _data(std::move(data)) {}
+            chunk( DataContainer&& data, uint32_t last_block_num ) : _data(std::move(data)), _last_block_num(last_block_num) {}
             ~chunk() = default;
 
             DataContainer _data;
+            uint32_t _last_block_num; // last block of the batch the data comes from, spans of the flush are attributed to it
           };
 
       private:
@@ -72,7 +75,7 @@ namespace hive::plugins::sql_serializer {
   {
     if(data.empty() == false)
     {
-      _processor->trigger(std::make_unique<chunk>(std::move(data)), last_block_num);
+      _processor->trigger(std::make_unique<chunk>(std::move(data), last_block_num), last_block_num);
     } else {
       _processor->only_report_batch_finished( last_block_num );
     }
@@ -107,6 +110,9 @@ namespace hive::plugins::sql_serializer {
 
     FC_ASSERT(data.empty() == false, "Data empty 2" );
 
+    static table_metrics& table_stats = metrics().table( TABLE_NAME );
+    const auto start_time = fc::time_point::now();
+
     std::string query = "INSERT INTO ";
     query += TABLE_NAME;
     query += '(';
@@ -123,7 +129,17 @@ namespace hive::plugins::sql_serializer {
 
     query += ';';
 
-    tx.exec(query);
+    const auto end_time = fc::time_point::now();
+    tracer().record( "convert", TABLE_NAME, holder->_last_block_num, start_time, end_time );
+    table_stats.conversion_time_us.observe( ( end_time - start_time ).count() );
+    table_stats.rows += data.size();
+    table_stats.bytes += query.size();
+
+    {
+      trace_span send_span( "send", holder->_last_block_num, TABLE_NAME );
+      metrics_timer send_timer( table_stats.send_time_us );
+      tx.exec(query);
+    }
 
     processingStatus.first += data.size();
     processingStatus.second = true;
@@ -145,6 +161,9 @@ namespace hive::plugins::sql_serializer {
 
     FC_ASSERT(data.empty() == false, "Data empty 3");
 
+    static table_metrics& table_stats = metrics().table( TABLE_NAME );
+    const auto start_time = fc::time_point::now();
+
     std::string query = "";
 
     auto dataI = data.cbegin();
@@ -155,6 +174,12 @@ namespace hive::plugins::sql_serializer {
       query += ",(" + conv(*dataI) + ")\n";
     }
 
+    const auto end_time = fc::time_point::now();
+    tracer().record( "convert", TABLE_NAME, holder->_last_block_num, start_time, end_time );
+    table_stats.conversion_time_us.observe( ( end_time - start_time ).count() );
+    table_stats.rows += data.size();
+    table_stats.bytes += query.size();
+
     callback( std::move(query) );
 
     processingStatus.first += data.size();
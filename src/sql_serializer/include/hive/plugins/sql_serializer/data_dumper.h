@@ -3,10 +3,16 @@
 #include <hive/plugins/sql_serializer/cached_data.h>
 
 namespace hive::plugins::sql_serializer {
+  /* DATABASE - data are written to the HAF database
+   * CONVERT_ONLY - data are converted to SQL tuples, but only the number of rows and bytes is counted
+   * CAPTURE_ONLY - data are collected from blocks and dropped without conversion
+   */
+  enum class DUMP_MODE{ DATABASE, CONVERT_ONLY, CAPTURE_ONLY };
+
   class data_dumper {
   public:
     virtual ~data_dumper() = default;
 
     virtual void trigger_data_flush( cached_data_t& cached_data, int last_block_num ) = 0;
   };
-} // namespace hive::plugins::sql_serializer
\ No newline at end of file
+} // namespace hive::plugins::sql_serializer
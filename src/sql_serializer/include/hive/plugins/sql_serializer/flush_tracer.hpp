@@ -0,0 +1,84 @@
+#pragma once
+
+#include <fc/time.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hive::plugins::sql_serializer {
+
+  /**
+   * @brief Records spans of the flush pipeline into a ring buffer, which can be dumped as Chrome trace-event JSON
+   *        ( chrome://tracing, https://ui.perfetto.dev ).
+   *
+   * Until enable() is called recording costs one atomic load. Span names and tables must be string literals or other
+   * strings which live until the end of the program, because only pointers are stored.
+   */
+  class flush_tracer {
+  public:
+    void enable( uint32_t capacity );
+    bool is_enabled() const { return _enabled.load( std::memory_order_relaxed ); }
+
+    void record( const char* name, const char* table, uint32_t block_num, fc::time_point start, fc::time_point end );
+    /// names the calling thread in the dumped trace
+    void set_thread_name( const std::string& name );
+
+    /// writes the events which are currently in the ring buffer, may be called concurrently with recording
+    void dump( const std::string& file_path ) const;
+
+  private:
+    /// a seqlock: fields are relaxed atomics, so dump() may read a slot while it is being overwritten
+    /// and detects that by the sequence changed around the reads
+    struct event {
+      std::atomic< uint64_t > sequence{ 0 }; // index of the recorded event + 1, 0 when the slot is being written or was never written
+      std::atomic< const char* > name{ nullptr };
+      std::atomic< const char* > table{ nullptr };
+      std::atomic< uint32_t > block_num{ 0 };
+      std::atomic< uint32_t > thread_id{ 0 };
+      std::atomic< int64_t > start_us{ 0 };
+      std::atomic< int64_t > duration_us{ 0 };
+    };
+
+    static uint32_t current_thread_id();
+
+  private:
+    std::atomic_bool _enabled{ false };
+    std::unique_ptr< event[] > _events;
+    uint32_t _capacity = 0;
+    std::atomic< uint64_t > _next_event{ 0 };
+
+    mutable std::mutex _thread_names_mutex;
+    std::map< uint32_t, std::string > _thread_names;
+  };
+
+  flush_tracer& tracer();
+
+  /// Records a span lasting from its construction to its destruction, if the tracer was enabled at construction
+  class trace_span {
+  public:
+    explicit trace_span( const char* name, uint32_t block_num = 0, const char* table = nullptr )
+      : _name( tracer().is_enabled() ? name : nullptr ), _table( table ), _block_num( block_num ) {
+      if ( _name )
+        _start = fc::time_point::now();
+    }
+
+    ~trace_span() {
+      if ( _name )
+        tracer().record( _name, _table, _block_num, _start, fc::time_point::now() );
+    }
+
+    trace_span( trace_span& ) = delete;
+    trace_span& operator=( trace_span& ) = delete;
+
+  private:
+    const char* const _name;
+    const char* const _table;
+    const uint32_t _block_num;
+    fc::time_point _start;
+  };
+
+} // namespace hive::plugins::sql_serializer
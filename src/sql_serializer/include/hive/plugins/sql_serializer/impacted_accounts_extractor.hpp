@@ -0,0 +1,76 @@
+#pragma once
+
+#include <hive/chain/full_block.hpp>
+#include <hive/protocol/operations.hpp>
+
+#include <boost/container/flat_set.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hive::plugins::sql_serializer {
+
+  /**
+   * Finds accounts impacted by operations of a block's transactions on worker threads.
+   *
+   * Impacted accounts of an operation depend only on the operation, so when a block starts to be applied,
+   * all its transactions' operations are split into chunks processed in parallel. The chain thread gets the result
+   * for an operation by its position in the block, waiting only when the chunk of the operation is not ready yet,
+   * so assigning sequence numbers of account operations still happens in order, on the chain thread.
+   * Virtual operations are unknown before they are produced, their impacted accounts are found by the caller.
+   */
+  class impacted_accounts_extractor
+  {
+    public:
+
+      using impacted_t = boost::container::flat_set<hive::protocol::account_name_type>;
+
+      explicit impacted_accounts_extractor( uint32_t threads_number );
+      ~impacted_accounts_extractor();
+
+      impacted_accounts_extractor( const impacted_accounts_extractor& ) = delete;
+      impacted_accounts_extractor& operator=( const impacted_accounts_extractor& ) = delete;
+
+      void start_block( const std::shared_ptr<hive::chain::full_block_type>& block );
+      /// nullptr when the operation is not a part of the current block
+      const impacted_t* get( int64_t trx_in_block, uint32_t op_in_trx );
+      /// waits until workers stop using the current block
+      void finish_block();
+
+    private:
+
+      static constexpr size_t chunk_size = 64;
+
+      struct chunk
+      {
+        size_t                    begin = 0;
+        size_t                    end = 0;
+        std::promise<void>        done;
+        std::shared_future<void>  ready;
+      };
+
+      void work();
+
+    private:
+
+      std::shared_ptr<hive::chain::full_block_type>   _block;
+      std::vector<const hive::protocol::operation*>   _operations;
+      /// index of the first operation of each transaction in `_operations`
+      std::vector<size_t>                             _transaction_offsets;
+      std::vector<impacted_t>                         _impacted;
+      std::deque<chunk>                               _chunks;
+
+      std::mutex                                      _mutex;
+      std::condition_variable                         _cv;
+      std::deque<chunk*>                              _queue;
+      bool                                            _stop = false;
+      std::vector<std::thread>                        _workers;
+  };
+
+} // namespace hive::plugins::sql_serializer
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <hive/plugins/sql_serializer/data_dumper.h>
 #include <hive/plugins/sql_serializer/indexes_controler.h>
 
 #include <boost/signals2.hpp>
@@ -13,7 +14,6 @@ namespace hive::chain{
 }
 
 namespace hive::plugins::sql_serializer {
-  class data_dumper;
   class sql_serializer_plugin;
   struct cached_data_t;
 
@@ -22,6 +22,17 @@ namespace hive::plugins::sql_serializer {
     public:
       class flush_trigger;
       static constexpr auto NO_IRREVERSIBLE_BLOCK = std::numeric_limits< int32_t >::max();
+      static constexpr int32_t REINDEX_BLOCKS_PER_FLUSH = 1000;
+      static constexpr int32_t P2P_MINIMUM_BLOCKS_PER_FLUSH = 1000;
+
+      // flush policies of the REINDEX and P2P triggers, public for tools which drive dumpers without hived
+      static bool is_reindex_flush_needed( int32_t last_block_num ) {
+        return last_block_num % REINDEX_BLOCKS_PER_FLUSH == 0;
+      }
+      static bool is_p2p_flush_needed( int32_t irreversible_block_num, int32_t last_flushed_block_num ) {
+        return irreversible_block_num != NO_IRREVERSIBLE_BLOCK
+          && ( irreversible_block_num - last_flushed_block_num ) >= P2P_MINIMUM_BLOCKS_PER_FLUSH;
+      }
 
       indexation_state(
           const sql_serializer_plugin& main_plugin
@@ -32,6 +43,7 @@ namespace hive::plugins::sql_serializer {
         , uint32_t psql_account_operations_threads_number
         , uint32_t psql_index_threshold
         , uint32_t psql_livesync_threshold
+        , DUMP_MODE dump_mode
       );
       ~indexation_state() = default;
       indexation_state& operator=( indexation_state& ) = delete;
@@ -69,6 +81,7 @@ namespace hive::plugins::sql_serializer {
       void force_trigger_flush_with_all_data( cached_data_t& cached_data, int last_block_num );
       bool can_move_to_livesync() const;
       uint32_t expected_number_of_blocks_to_sync() const;
+      bool is_dumping_to_database() const { return _dump_mode == DUMP_MODE::DATABASE; }
 
     private:
       const sql_serializer_plugin& _main_plugin;
@@ -78,6 +91,7 @@ namespace hive::plugins::sql_serializer {
       const uint32_t _psql_operations_threads_number;
       const uint32_t _psql_account_operations_threads_number;
       const uint32_t _psql_livesync_threshold;
+      const DUMP_MODE _dump_mode;
 
       boost::signals2::connection _on_irreversible_block_conn;
       INDEXATION _state{ INDEXATION::P2P };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <hive/plugins/sql_serializer/data_dumper.h>
+
+#include <fc/time.hpp>
+
+#include <cstdint>
+
+namespace hive::plugins::sql_serializer {
+
+  /**
+   * @brief Dumper which never touches a database, used to profile the sql_serializer itself.
+   *
+   * In CONVERT_ONLY mode all cached rows are converted by the same data2sql_tuple functors which are used
+   * to fill the database, but the produced SQL is discarded. Conversion is done synchronously in the calling thread,
+   * so its time is not mixed with the chain processing. In CAPTURE_ONLY mode cached rows are dropped without conversion.
+   */
+  class null_data_dumper : public data_dumper {
+  public:
+    explicit null_data_dumper( DUMP_MODE mode );
+
+    ~null_data_dumper();
+    null_data_dumper(null_data_dumper&) = delete;
+    null_data_dumper(null_data_dumper&&) = delete;
+    null_data_dumper& operator=(null_data_dumper&&) = delete;
+    null_data_dumper& operator=(null_data_dumper&) = delete;
+
+    void trigger_data_flush( cached_data_t& cached_data, int last_block_num ) override;
+
+  private:
+    struct table_statistics {
+      uint64_t rows = 0;
+      uint64_t bytes = 0;
+      fc::microseconds conversion_time;
+    };
+
+    template< typename TableDescriptor >
+    void convert( typename TableDescriptor::container_t&& data, table_statistics& statistics );
+
+    void log_statistics( int last_block_num ) const;
+
+  private:
+    const DUMP_MODE _mode;
+
+    table_statistics _blocks;
+    table_statistics _transactions;
+    table_statistics _transactions_multisig;
+    table_statistics _operations;
+    table_statistics _accounts;
+    table_statistics _account_operations;
+    table_statistics _applied_hardforks;
+
+    uint64_t _flushes = 0;
+    int _last_block_num = 0;
+  };
+
+} // namespace hive::plugins::sql_serializer
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <hive/protocol/operations.hpp>
+
+#include <fc/io/json.hpp>
+#include <fc/reflect/reflect.hpp>
+#include <fc/variant.hpp>
+
+#include <boost/container/flat_set.hpp>
+#include <boost/program_options.hpp>
+
+#include <functional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace hive::plugins::sql_serializer {
+
+  using hive::protocol::operation;
+
+  /**
+   * Compares a value of a field of an operation with a value given in a predicate. Values are compared as texts:
+   * strings and account names directly, numbers and booleans in their decimal/`true`/`false` form, other types
+   * in their JSON form. A collection (e.g. `required_posting_auths`) matches when any of its elements matches.
+   */
+  class field_matcher
+  {
+    public:
+
+      enum class kind { equal, prefix, in };
+
+      field_matcher( kind k, std::set<std::string> values );
+
+      template<typename T>
+      bool matches( const T& field ) const;
+
+    private:
+
+      template<typename T>
+      struct is_collection: std::false_type {};
+      template<typename T, typename... Args>
+      struct is_collection<boost::container::flat_set<T, Args...>>: std::true_type {};
+      template<typename T, typename... Args>
+      struct is_collection<std::set<T, Args...>>: std::true_type {};
+      template<typename T, typename... Args>
+      struct is_collection<std::vector<T, Args...>>: std::integral_constant<bool, !std::is_same<T, char>::value> {};
+
+      template<typename T>
+      static std::string to_text( const T& field );
+
+      bool matches_text( const std::string& text ) const;
+
+      kind                  _kind;
+      std::set<std::string> _values;
+  };
+
+  /**
+   * Predicates on fields of operations from `psql-track-operation-predicates` options, each in the form:
+   *   <operation>.<field>[.<field>...] <matcher> <JSON value>
+   * where the matcher is `==`, `prefix` or `in` (a JSON array of values), e.g.
+   *   custom_json_operation.id in ["podping","pp_video_update"]
+   *   transfer_operation.to == "gtg"
+   * Paths are resolved with fc reflection once, when options are read, so an operation is checked directly
+   * on its fields, without converting it to JSON. An operation is tracked when any predicate for its type matches,
+   * operations of types without predicates are not tracked.
+   */
+  class operation_predicates
+  {
+    public:
+
+      using predicate_t = std::function<bool( const operation& )>;
+
+      void fill( const boost::program_options::variables_map& options, const std::string& option_name );
+      void add( const std::string& predicate );
+
+      bool empty() const { return _empty; }
+      bool is_tracked_operation( const operation& op ) const;
+
+    private:
+
+      bool                                   _empty = true;
+      /// predicates indexed by `operation::which()`
+      std::vector<std::vector<predicate_t>>  _predicates;
+  };
+
+  template<typename T>
+  std::string field_matcher::to_text( const T& field )
+  {
+    if constexpr( std::is_same<T, bool>::value )
+      return field ? "true" : "false";
+    else if constexpr( std::is_integral<T>::value )
+      return std::to_string( field );
+    else if constexpr( std::is_convertible<T, std::string>::value )
+      return static_cast<std::string>( field );
+    else
+    {
+      fc::variant _value( field );
+      return _value.is_object() || _value.is_array() || _value.is_null() ? fc::json::to_string( _value ) : _value.as_string();
+    }
+  }
+
+  template<typename T>
+  bool field_matcher::matches( const T& field ) const
+  {
+    if constexpr( is_collection<T>::value )
+    {
+      for( const auto& _element : field )
+        if( matches( _element ) )
+          return true;
+      return false;
+    }
+    else
+      return matches_text( to_text( field ) );
+  }
+
+} // namespace hive::plugins::sql_serializer
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <fc/time.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace hive::plugins::sql_serializer {
+
+  /**
+   * @brief Lock-free histogram with power of two buckets, bucket `i` counts values in range ( 2^(i-1), 2^i ].
+   */
+  class metrics_histogram {
+  public:
+    static constexpr size_t BUCKETS = 40;
+
+    void observe( uint64_t value );
+
+    uint64_t count() const { return _count.load( std::memory_order_relaxed ); }
+    uint64_t sum() const { return _sum.load( std::memory_order_relaxed ); }
+
+    /// appends the histogram in prometheus text format, labels are without braces, e.g. `table="hive.blocks"`
+    void to_prometheus( std::string& output, const std::string& name, const std::string& labels ) const;
+
+  private:
+    std::array< std::atomic< uint64_t >, BUCKETS + 1 > _buckets{}; // the last one is +Inf
+    std::atomic< uint64_t > _sum{ 0 };
+    std::atomic< uint64_t > _count{ 0 };
+  };
+
+  struct table_metrics {
+    const char* const table;
+
+    std::atomic< uint64_t > rows{ 0 };
+    std::atomic< uint64_t > bytes{ 0 };
+    metrics_histogram conversion_time_us;
+    metrics_histogram send_time_us;
+  };
+
+  /**
+   * @brief Counters of the whole serialization pipeline, updated concurrently by writers threads.
+   */
+  class serializer_metrics {
+  public:
+    /// table_name is a TABLE of the tables descriptions, e.g. `hive.operations`
+    table_metrics& table( const char* table_name );
+
+    std::string to_prometheus() const;
+
+    std::atomic< uint64_t > blocks{ 0 };
+    std::atomic< uint64_t > operations{ 0 };
+    std::atomic< uint64_t > flushes{ 0 };
+    std::atomic< uint64_t > cached_data_bytes{ 0 };
+
+    metrics_histogram flush_batch_blocks;
+    metrics_histogram commit_time_us;
+    metrics_histogram rendezvous_wait_us;
+    metrics_histogram queue_wait_us;
+
+  private:
+    std::array< table_metrics, 7 > _tables{ {
+        { "hive.blocks" }
+      , { "hive.transactions" }
+      , { "hive.transactions_multisig" }
+      , { "hive.operations" }
+      , { "hive.accounts" }
+      , { "hive.account_operations" }
+      , { "hive.applied_hardforks" }
+    } };
+  };
+
+  serializer_metrics& metrics();
+
+  /// Observes time elapsed between its construction and destruction, in microseconds
+  class metrics_timer {
+  public:
+    explicit metrics_timer( metrics_histogram& histogram ) : _histogram( histogram ), _start( fc::time_point::now() ) {}
+    ~metrics_timer() { _histogram.observe( ( fc::time_point::now() - _start ).count() ); }
+
+    metrics_timer( metrics_timer& ) = delete;
+    metrics_timer& operator=( metrics_timer& ) = delete;
+
+  private:
+    metrics_histogram& _histogram;
+    const fc::time_point _start;
+  };
+
+  /**
+   * @brief Periodically writes metrics() in prometheus text format to a file, which may be read by node_exporter textfile collector.
+   */
+  class metrics_file_writer {
+  public:
+    metrics_file_writer( std::string file_path, uint32_t interval_seconds );
+    ~metrics_file_writer();
+
+    metrics_file_writer( metrics_file_writer& ) = delete;
+    metrics_file_writer( metrics_file_writer&& ) = delete;
+    metrics_file_writer& operator=( metrics_file_writer& ) = delete;
+    metrics_file_writer& operator=( metrics_file_writer&& ) = delete;
+
+  private:
+    void write() const;
+
+  private:
+    const std::string _file_path;
+    const std::chrono::seconds _interval;
+    bool _stop = false;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+  };
+
+} // namespace hive::plugins::sql_serializer
@@ -1,9 +1,12 @@
 #include <hive/plugins/sql_serializer/indexation_state.hpp>
 
 #include <hive/plugins/sql_serializer/cached_data.h>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
 #include <hive/plugins/sql_serializer/sql_serializer_plugin.hpp>
 #include <hive/plugins/sql_serializer/livesync_data_dumper.h>
+#include <hive/plugins/sql_serializer/null_data_dumper.h>
 #include <hive/plugins/sql_serializer/reindex_data_dumper.h>
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
 
 #include <fc/exception/exception.hpp>
 #include <fc/log/logger.hpp>
@@ -69,8 +72,7 @@ public:
   reindex_flush_trigger( flush_data_callback callback ) : _flush_data_callback( callback ) {}
   ~reindex_flush_trigger() override = default;
   void flush( cached_data_t& cached_data, int32_t last_block_num, int32_t irreversible_block_num ) override {
-    constexpr auto BLOCKS_PER_FLUSH = 1000;
-    if( last_block_num % BLOCKS_PER_FLUSH == 0 )
+    if( indexation_state::is_reindex_flush_needed( last_block_num ) )
     {
       _flush_data_callback( cached_data, last_block_num );
     }
@@ -94,7 +96,6 @@ private:
 class p2p_flush_trigger : public indexation_state::flush_trigger {
 public:
   using flush_data_callback = std::function< void(cached_data_t& cached_data, int) >;
-  static constexpr auto MINIMUM_BLOCKS_PER_FLUSH = 1000;
 
   p2p_flush_trigger( const sql_serializer_plugin& plugin, hive::chain::database& chain_db, flush_data_callback callback )
     : _flush_data_callback( callback )
@@ -105,11 +106,7 @@ public:
   ~p2p_flush_trigger() override = default;
 
   void flush( cached_data_t& cached_data, int32_t last_block_num, int32_t irreversible_block_num ) override {
-    if ( irreversible_block_num == indexation_state::NO_IRREVERSIBLE_BLOCK ) {
-      return;
-    }
-
-    if ( (irreversible_block_num - last_flushed_block_num) < MINIMUM_BLOCKS_PER_FLUSH ) {
+    if ( !indexation_state::is_p2p_flush_needed( irreversible_block_num, last_flushed_block_num ) ) {
       return;
     }
 
@@ -134,6 +131,7 @@ indexation_state::indexation_state(
   , uint32_t psql_account_operations_threads_number
   , uint32_t psql_index_threshold
   , uint32_t psql_livesync_threshold
+  , DUMP_MODE dump_mode
 )
   : _main_plugin( main_plugin )
   , _chain_db( chain_db )
@@ -142,6 +140,7 @@ indexation_state::indexation_state(
   , _psql_operations_threads_number( psql_operations_threads_number )
   , _psql_account_operations_threads_number( psql_account_operations_threads_number )
   , _psql_livesync_threshold( psql_livesync_threshold )
+  , _dump_mode( dump_mode )
   , _irreversible_block_num( NO_IRREVERSIBLE_BLOCK )
   , _indexes_controler( db_url, psql_index_threshold )
 {
@@ -182,8 +181,10 @@ indexation_state::on_post_reindex( cached_data_t& cached_data, uint32_t last_blo
     force_trigger_flush_with_all_data( cached_data, last_block_num );
     _trigger.reset();
     _dumper.reset();
-    _indexes_controler.enable_indexes();
-    _indexes_controler.enable_constrains();
+    if ( is_dumping_to_database() ) {
+      _indexes_controler.enable_indexes();
+      _indexes_controler.enable_constrains();
+    }
     return;
   }
 
@@ -239,14 +240,18 @@ indexation_state::update_state(
       force_trigger_flush_with_all_data( cached_data, last_block_num );
       _trigger.reset();
       _dumper.reset();
-      _indexes_controler.disable_constraints();
-      _indexes_controler.disable_indexes_depends_on_blocks( expected_number_of_blocks_to_sync() );
-      _dumper = std::make_shared< reindex_data_dumper >(
-          _db_url
-        , _psql_operations_threads_number
-        , _psql_transactions_threads_number
-        , _psql_account_operations_threads_number
-      );
+      if ( is_dumping_to_database() ) {
+        _indexes_controler.disable_constraints();
+        _indexes_controler.disable_indexes_depends_on_blocks( expected_number_of_blocks_to_sync() );
+        _dumper = std::make_shared< reindex_data_dumper >(
+            _db_url
+          , _psql_operations_threads_number
+          , _psql_transactions_threads_number
+          , _psql_account_operations_threads_number
+        );
+      } else {
+        _dumper = std::make_shared< null_data_dumper >( _dump_mode );
+      }
       _irreversible_block_num = NO_IRREVERSIBLE_BLOCK;
       _trigger = std::make_unique< p2p_flush_trigger >(
           _main_plugin
@@ -263,18 +268,22 @@ indexation_state::update_state(
       force_trigger_flush_with_all_data( cached_data, last_block_num );
       _trigger.reset();
       _dumper.reset();
-      _indexes_controler.disable_constraints();
-      _indexes_controler.disable_indexes_depends_on_blocks(
-        number_of_blocks_to_add == 0 // stop_replay_at_block = 0
-        ? expected_number_of_blocks_to_sync()
-        : number_of_blocks_to_add
-      );
-      _dumper = std::make_shared< reindex_data_dumper >(
-          _db_url
-        , _psql_operations_threads_number
-        , _psql_transactions_threads_number
-        , _psql_account_operations_threads_number
-      );
+      if ( is_dumping_to_database() ) {
+        _indexes_controler.disable_constraints();
+        _indexes_controler.disable_indexes_depends_on_blocks(
+          number_of_blocks_to_add == 0 // stop_replay_at_block = 0
+          ? expected_number_of_blocks_to_sync()
+          : number_of_blocks_to_add
+        );
+        _dumper = std::make_shared< reindex_data_dumper >(
+            _db_url
+          , _psql_operations_threads_number
+          , _psql_transactions_threads_number
+          , _psql_account_operations_threads_number
+        );
+      } else {
+        _dumper = std::make_shared< null_data_dumper >( _dump_mode );
+      }
       _trigger = std::make_unique< reindex_flush_trigger >(
         [this]( cached_data_t& cached_data, int last_block_num ) {
           force_trigger_flush_with_all_data( cached_data, last_block_num );
@@ -290,16 +299,20 @@ indexation_state::update_state(
         }
         _trigger.reset();
         _dumper.reset();
-        _indexes_controler.enable_indexes();
-        _indexes_controler.enable_constrains();
-        _dumper = std::make_unique< livesync_data_dumper >(
-          _db_url
-          , _main_plugin
-          , _chain_db
-          , _psql_operations_threads_number
-          , _psql_transactions_threads_number
-          , _psql_account_operations_threads_number
-          );
+        if ( is_dumping_to_database() ) {
+          _indexes_controler.enable_indexes();
+          _indexes_controler.enable_constrains();
+          _dumper = std::make_unique< livesync_data_dumper >(
+            _db_url
+            , _main_plugin
+            , _chain_db
+            , _psql_operations_threads_number
+            , _psql_transactions_threads_number
+            , _psql_account_operations_threads_number
+            );
+        } else {
+          _dumper = std::make_shared< null_data_dumper >( _dump_mode );
+        }
         _trigger = std::make_unique< live_flush_trigger >(
           [this]( cached_data_t& cached_data, int last_block_num ) {
             force_trigger_flush_with_all_data( cached_data, last_block_num );
@@ -325,6 +338,9 @@ indexation_state::force_trigger_flush_with_all_data( cached_data_t& cached_data,
   if ( cached_data.blocks.empty() ) {
     return;
   }
+  trace_span flush_span( "flush", last_block_num );
+  ++metrics().flushes;
+  metrics().flush_batch_blocks.observe( cached_data.blocks.size() );
   _dumper->trigger_data_flush( cached_data, last_block_num );
 }
 
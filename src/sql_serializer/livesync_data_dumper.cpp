@@ -1,4 +1,5 @@
 #include <hive/plugins/sql_serializer/livesync_data_dumper.h>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
 #include <transactions_controller/transaction_controllers.hpp>
 
 #include <hive/chain/database.hpp>
@@ -37,6 +38,7 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
     auto NUMBER_OF_PROCESSORS_THREADS = ONE_THREAD_WRITERS_NUMBER + operations_threads + transactions_threads + account_operation_threads;
     auto execute_push_block = [this](block_num_rendezvous_trigger::BLOCK_NUM _block_num ){
       if ( !_block.empty() ) {
+        trace_span push_block_span( "push_block", _block_num );
         auto transaction = transactions_controller->openTx();
 
         std::string block_to_dump = _block + "::hive.blocks";
@@ -108,6 +110,7 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
 
   void livesync_data_dumper::trigger_data_flush( cached_data_t& cached_data, int last_block_num ) {
     FC_ASSERT( cached_data.blocks.size() == 1, "LIVE sync can only process one block" );
+    trace_span trigger_span( "trigger writers", last_block_num );
     _block_writer->trigger( std::move( cached_data.blocks ), last_block_num );
     _operation_writer->trigger( std::move( cached_data.operations ), last_block_num );
     _transaction_writer->trigger( std::move( cached_data.transactions ), last_block_num);
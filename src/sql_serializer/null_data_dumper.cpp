@@ -0,0 +1,76 @@
+#include <hive/plugins/sql_serializer/null_data_dumper.h>
+
+#include <hive/plugins/sql_serializer/tables_descriptions.h>
+
+#include <fc/log/logger.hpp>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  namespace {
+    constexpr auto BLOCKS_PER_STATISTICS = 100'000;
+  } // namespace
+
+  null_data_dumper::null_data_dumper( DUMP_MODE mode )
+  : _mode( mode ) {
+    FC_ASSERT( _mode != DUMP_MODE::DATABASE, "null dumper cannot dump data to the database" );
+    ilog( "Starting null dumper, nothing will be written to the database. Conversion to SQL is ${c}"
+      , ("c", _mode == DUMP_MODE::CONVERT_ONLY ? "enabled" : "disabled" ) );
+  }
+
+  null_data_dumper::~null_data_dumper() {
+    ilog( "Null dumper is closing...." );
+    log_statistics( _last_block_num );
+  }
+
+  void null_data_dumper::trigger_data_flush( cached_data_t& cached_data, int last_block_num ) {
+    // data are moved out of the cache in the same way the database dumpers do it
+    convert< hive_blocks >( std::move( cached_data.blocks ), _blocks );
+    convert< hive_transactions< std::vector< PSQL::processing_objects::process_transaction_t > > >( std::move( cached_data.transactions ), _transactions );
+    convert< hive_transactions_multisig >( std::move( cached_data.transactions_multisig ), _transactions_multisig );
+    convert< hive_operations< std::vector< PSQL::processing_objects::process_operation_t > > >( std::move( cached_data.operations ), _operations );
+    convert< hive_accounts >( std::move( cached_data.accounts ), _accounts );
+    convert< hive_account_operations< std::vector< PSQL::processing_objects::account_operation_data_t > > >( std::move( cached_data.account_operations ), _account_operations );
+    convert< hive_applied_hardforks >( std::move( cached_data.applied_hardforks ), _applied_hardforks );
+
+    ++_flushes;
+    if ( last_block_num / BLOCKS_PER_STATISTICS != _last_block_num / BLOCKS_PER_STATISTICS ) {
+      log_statistics( last_block_num );
+    }
+    _last_block_num = last_block_num;
+  }
+
+  template< typename TableDescriptor >
+  void null_data_dumper::convert( typename TableDescriptor::container_t&& data, table_statistics& statistics ) {
+    const typename TableDescriptor::container_t rows( std::move( data ) );
+    statistics.rows += rows.size();
+
+    if ( _mode != DUMP_MODE::CONVERT_ONLY ) {
+      return;
+    }
+
+    const auto start_time = fc::time_point::now();
+    typename TableDescriptor::data2sql_tuple conv;
+    for ( const auto& row : rows ) {
+      // '(' + tuple + ")\n," like the database writers build VALUES lists
+      statistics.bytes += conv( row ).size() + 4;
+    }
+    statistics.conversion_time += fc::time_point::now() - start_time;
+  }
+
+  void null_data_dumper::log_statistics( int last_block_num ) const {
+    auto log_table = [this]( const char* table, const table_statistics& statistics ) {
+      ilog( "${t}: rows: ${r} bytes: ${b} conversion time: ${time} ms"
+        , ("t", table)("r", statistics.rows)("b", statistics.bytes)("time", statistics.conversion_time.count() / 1000.0 ) );
+    };
+
+    ilog( "Null dumper statistics at block ${b}, flushes: ${f}", ("b", last_block_num)("f", _flushes) );
+    log_table( hive_blocks::TABLE, _blocks );
+    log_table( "hive.transactions", _transactions );
+    log_table( hive_transactions_multisig::TABLE, _transactions_multisig );
+    log_table( "hive.operations", _operations );
+    log_table( hive_accounts::TABLE, _accounts );
+    log_table( "hive.account_operations", _account_operations );
+    log_table( hive_applied_hardforks::TABLE, _applied_hardforks );
+  }
+
+}}} // namespace hive::plugins::sql_serializer
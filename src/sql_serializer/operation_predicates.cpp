@@ -0,0 +1,198 @@
+#include <hive/plugins/sql_serializer/operation_predicates.hpp>
+
+#include <hive/plugins/sql_serializer/sql_serializer_objects.hpp>
+
+#include <fc/exception/exception.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+#include <map>
+#include <sstream>
+#include <type_traits>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  namespace
+  {
+    template<typename Class>
+    std::function<bool( const Class& )> resolve_field( const std::vector<std::string>& path, size_t depth, const field_matcher& matcher );
+
+    /// Visits reflected members of `Class` and builds an accessor of the member named by `path[depth]`
+    template<typename Class>
+    struct field_resolver
+    {
+      const std::vector<std::string>&               path;
+      size_t                                        depth;
+      const field_matcher&                          matcher;
+      mutable std::function<bool( const Class& )>   result;
+
+      template<typename Member, class Owner, Member (Owner::*member)>
+      void operator()( const char* name ) const
+      {
+        if( result || path[ depth ] != name )
+          return;
+
+        if( depth + 1 == path.size() )
+        {
+          result = [ _matcher = matcher ]( const Class& object ){ return _matcher.matches( object.*member ); };
+        }
+        else if constexpr( fc::reflector<Member>::is_defined::value && !std::is_enum<Member>::value )
+        {
+          auto _nested = resolve_field<Member>( path, depth + 1, matcher );
+          if( _nested )
+            result = [ _nested ]( const Class& object ){ return _nested( object.*member ); };
+        }
+      }
+    };
+
+    template<typename Class>
+    std::function<bool( const Class& )> resolve_field( const std::vector<std::string>& path, size_t depth, const field_matcher& matcher )
+    {
+      field_resolver<Class> _resolver{ path, depth, matcher, {} };
+      fc::reflector<Class>::visit( _resolver );
+      return _resolver.result;
+    }
+
+    struct predicate_compiler
+    {
+      using result_type = operation_predicates::predicate_t;
+
+      const std::vector<std::string>& path;
+      const field_matcher&            matcher;
+
+      template<typename Operation>
+      result_type operator()( const Operation& ) const
+      {
+        auto _field = resolve_field<Operation>( path, 0, matcher );
+        if( !_field )
+          return result_type();
+
+        return [ _field ]( const operation& op ){ return _field( op.get<Operation>() ); };
+      }
+    };
+
+    /// Operation type ids by names of types, both `custom_json_operation` and `custom_json` are accepted
+    const std::map<std::string, int32_t>& operation_type_ids()
+    {
+      static const auto _ids = []
+      {
+        std::map<std::string, int32_t> _result;
+        operation _op;
+        for( int32_t _type_id = 0; _type_id < operation::count(); ++_type_id )
+        {
+          _op.set_which( _type_id );
+          std::string _name = _op.visit( PSQL::name_gathering_visitor() );
+          _name = _name.substr( _name.rfind( ':' ) + 1 );
+
+          _result.emplace( _name, _type_id );
+          if( boost::algorithm::ends_with( _name, "_operation" ) )
+            _result.emplace( _name.substr( 0, _name.size() - std::string( "_operation" ).size() ), _type_id );
+        }
+        return _result;
+      }();
+      return _ids;
+    }
+
+    std::string scalar_to_text( const fc::variant& value, const std::string& predicate )
+    {
+      FC_ASSERT( !value.is_object() && !value.is_array() && !value.is_null(), "Predicate ${p} compares a field with a value which is not a string, a number or a boolean", ("p", predicate) );
+      return value.is_bool() ? ( value.as_bool() ? "true" : "false" ) : value.as_string();
+    }
+  }
+
+  field_matcher::field_matcher( kind k, std::set<std::string> values ): _kind( k ), _values( std::move( values ) )
+  {
+  }
+
+  bool field_matcher::matches_text( const std::string& text ) const
+  {
+    switch( _kind )
+    {
+      case kind::equal:
+      case kind::in:
+        return _values.find( text ) != _values.end();
+      case kind::prefix:
+        return boost::algorithm::starts_with( text, *_values.begin() );
+    }
+    return false;
+  }
+
+  void operation_predicates::fill( const boost::program_options::variables_map& options, const std::string& option_name )
+  {
+    if( !options.count( option_name ) )
+      return;
+
+    for( const std::string& _predicate : options[ option_name ].as<std::vector<std::string>>() )
+      add( _predicate );
+  }
+
+  void operation_predicates::add( const std::string& predicate )
+  {
+    std::istringstream _stream( predicate );
+    std::string _path_text, _kind_text, _value_text;
+    _stream >> _path_text >> _kind_text;
+    std::getline( _stream, _value_text );
+    boost::algorithm::trim( _value_text );
+
+    FC_ASSERT( !_path_text.empty() && !_kind_text.empty() && !_value_text.empty(),
+      "Predicate ${p} has to be in the form: <operation>.<field> ==|prefix|in <JSON value>", ("p", predicate) );
+
+    std::vector<std::string> _path;
+    boost::algorithm::split( _path, _path_text, boost::algorithm::is_any_of( "." ) );
+    FC_ASSERT( _path.size() >= 2, "Predicate ${p} does not contain a field of an operation", ("p", predicate) );
+
+    const auto _type = operation_type_ids().find( _path.front() );
+    FC_ASSERT( _type != operation_type_ids().end(), "Unknown operation type ${t} in predicate ${p}", ("t", _path.front())("p", predicate) );
+    _path.erase( _path.begin() );
+
+    const fc::variant _value = fc::json::from_string( _value_text );
+    std::set<std::string> _values;
+    field_matcher::kind _kind = field_matcher::kind::equal;
+
+    if( _kind_text == "==" )
+    {
+      _kind = field_matcher::kind::equal;
+      _values.insert( scalar_to_text( _value, predicate ) );
+    }
+    else if( _kind_text == "prefix" )
+    {
+      FC_ASSERT( _value.is_string(), "Prefix in predicate ${p} has to be a string", ("p", predicate) );
+      _kind = field_matcher::kind::prefix;
+      _values.insert( _value.as_string() );
+    }
+    else if( _kind_text == "in" )
+    {
+      FC_ASSERT( _value.is_array(), "Values in predicate ${p} have to be a JSON array", ("p", predicate) );
+      _kind = field_matcher::kind::in;
+      for( const auto& _item : _value.get_array() )
+        _values.insert( scalar_to_text( _item, predicate ) );
+    }
+    else
+      FC_THROW( "Unknown matcher ${m} in predicate ${p}, expected `==`, `prefix` or `in`", ("m", _kind_text)("p", predicate) );
+
+    const field_matcher _matcher( _kind, std::move( _values ) );
+
+    operation _op;
+    _op.set_which( _type->second );
+    auto _compiled = _op.visit( predicate_compiler{ _path, _matcher } );
+    FC_ASSERT( _compiled, "Operation ${t} does not have a field ${f} used in predicate ${p}",
+      ("t", _type->first)("f", boost::algorithm::join( _path, "." ))("p", predicate) );
+
+    _predicates.resize( operation::count() );
+    _predicates[ _type->second ].emplace_back( std::move( _compiled ) );
+    _empty = false;
+  }
+
+  bool operation_predicates::is_tracked_operation( const operation& op ) const
+  {
+    if( _empty )
+      return false;
+
+    for( const auto& _predicate : _predicates[ op.which() ] )
+      if( _predicate( op ) )
+        return true;
+
+    return false;
+  }
+
+}}} // namespace hive::plugins::sql_serializer
@@ -1,4 +1,6 @@
 #include <hive/plugins/sql_serializer/queries_commit_data_processor.h>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
 
 namespace hive{ namespace plugins{ namespace sql_serializer {
 queries_commit_data_processor::queries_commit_data_processor(const std::string& psqlUrl, std::string description, const data_processing_fn& dataProcessor, std::shared_ptr< block_num_rendezvous_trigger > api_trigger ) {
@@ -6,7 +8,11 @@ queries_commit_data_processor::queries_commit_data_processor(const std::string&
   auto fn_wrapped_with_transaction = [ tx_controller, dataProcessor ]( const data_chunk_ptr& dataPtr ){
     transaction_ptr tx( tx_controller->openTx() );
     auto result = dataProcessor( dataPtr, *tx );
-    tx->commit();
+    {
+      trace_span commit_span( "commit" );
+      metrics_timer commit_timer( metrics().commit_time_us );
+      tx->commit();
+    }
 
     return result;
   };
@@ -1,4 +1,5 @@
 #include <hive/plugins/sql_serializer/reindex_data_dumper.h>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
 
 #include <exception>
 
@@ -44,6 +45,7 @@ namespace hive{ namespace plugins{ namespace sql_serializer {
   }
 
   void reindex_data_dumper::trigger_data_flush( cached_data_t& cached_data, int last_block_num ) {
+    trace_span trigger_span( "trigger writers", last_block_num );
     _block_writer->trigger( std::move( cached_data.blocks ), last_block_num );
     _transaction_writer->trigger( std::move( cached_data.transactions ), last_block_num);
     _operation_writer->trigger( std::move( cached_data.operations ), last_block_num );
@@ -0,0 +1,124 @@
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace hive{ namespace plugins{ namespace sql_serializer {
+
+  void metrics_histogram::observe( uint64_t value ) {
+    size_t bucket = 0;
+    while ( bucket < BUCKETS && value > ( uint64_t( 1 ) << bucket ) )
+      ++bucket;
+
+    _buckets[ bucket ].fetch_add( 1, std::memory_order_relaxed );
+    _sum.fetch_add( value, std::memory_order_relaxed );
+    _count.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  void metrics_histogram::to_prometheus( std::string& output, const std::string& name, const std::string& labels ) const {
+    const std::string separator = labels.empty() ? "" : ",";
+    output += "# TYPE " + name + " histogram\n";
+
+    uint64_t cumulative = 0;
+    for ( size_t bucket = 0; bucket < BUCKETS; ++bucket ) {
+      cumulative += _buckets[ bucket ].load( std::memory_order_relaxed );
+      output += name + "_bucket{" + labels + separator + "le=\"" + std::to_string( uint64_t( 1 ) << bucket ) + "\"} " + std::to_string( cumulative ) + "\n";
+    }
+    cumulative += _buckets[ BUCKETS ].load( std::memory_order_relaxed );
+    output += name + "_bucket{" + labels + separator + "le=\"+Inf\"} " + std::to_string( cumulative ) + "\n";
+
+    const std::string braced_labels = labels.empty() ? "" : "{" + labels + "}";
+    output += name + "_sum" + braced_labels + " " + std::to_string( sum() ) + "\n";
+    output += name + "_count" + braced_labels + " " + std::to_string( count() ) + "\n";
+  }
+
+  table_metrics& serializer_metrics::table( const char* table_name ) {
+    for ( auto& table : _tables ) {
+      if ( std::strcmp( table.table, table_name ) == 0 )
+        return table;
+    }
+
+    FC_THROW( "No metrics for table ${t}", ("t", table_name) );
+  }
+
+  std::string serializer_metrics::to_prometheus() const {
+    std::string output;
+    auto add_counter = [&output]( const std::string& name, uint64_t value, const char* type = "counter" ) {
+      output += "# TYPE " + name + " " + type + "\n" + name + " " + std::to_string( value ) + "\n";
+    };
+
+    add_counter( "haf_serializer_blocks_total", blocks.load() );
+    add_counter( "haf_serializer_operations_total", operations.load() );
+    add_counter( "haf_serializer_flushes_total", flushes.load() );
+    add_counter( "haf_serializer_cached_data_bytes", cached_data_bytes.load(), "gauge" );
+
+    output += "# TYPE haf_serializer_table_rows_total counter\n";
+    for ( const auto& table : _tables )
+      output += "haf_serializer_table_rows_total{table=\"" + std::string( table.table ) + "\"} " + std::to_string( table.rows.load() ) + "\n";
+    output += "# TYPE haf_serializer_table_bytes_total counter\n";
+    for ( const auto& table : _tables )
+      output += "haf_serializer_table_bytes_total{table=\"" + std::string( table.table ) + "\"} " + std::to_string( table.bytes.load() ) + "\n";
+
+    for ( const auto& table : _tables ) {
+      const std::string labels = "table=\"" + std::string( table.table ) + "\"";
+      table.conversion_time_us.to_prometheus( output, "haf_serializer_conversion_time_us", labels );
+      table.send_time_us.to_prometheus( output, "haf_serializer_send_time_us", labels );
+    }
+
+    flush_batch_blocks.to_prometheus( output, "haf_serializer_flush_batch_blocks", "" );
+    commit_time_us.to_prometheus( output, "haf_serializer_commit_time_us", "" );
+    rendezvous_wait_us.to_prometheus( output, "haf_serializer_rendezvous_wait_us", "" );
+    queue_wait_us.to_prometheus( output, "haf_serializer_queue_wait_us", "" );
+
+    return output;
+  }
+
+  serializer_metrics& metrics() {
+    static serializer_metrics instance;
+    return instance;
+  }
+
+  metrics_file_writer::metrics_file_writer( std::string file_path, uint32_t interval_seconds )
+  : _file_path( std::move( file_path ) )
+  , _interval( std::max( interval_seconds, 1u ) ) {
+    ilog( "Serializer metrics will be written to ${f} every ${i} s", ("f", _file_path)("i", _interval.count()) );
+    _thread = std::thread( [this]{
+      std::unique_lock< std::mutex > lock( _mutex );
+      while ( !_cv.wait_for( lock, _interval, [this]{ return _stop; } ) ) {
+        write();
+      }
+    } );
+  }
+
+  metrics_file_writer::~metrics_file_writer() {
+    {
+      std::lock_guard< std::mutex > lock( _mutex );
+      _stop = true;
+    }
+    _cv.notify_one();
+    _thread.join();
+    write();
+  }
+
+  void metrics_file_writer::write() const {
+    // write to a temporary file and rename, to never expose a partially written file to a scraper
+    const auto temporary_path = _file_path + ".tmp";
+    {
+      std::ofstream file( temporary_path, std::ios::trunc );
+      if ( !file ) {
+        wlog( "Cannot write serializer metrics to ${f}", ("f", temporary_path) );
+        return;
+      }
+      file << metrics().to_prometheus();
+    }
+
+    if ( std::rename( temporary_path.c_str(), _file_path.c_str() ) != 0 )
+      wlog( "Cannot rename ${t} to ${f}", ("t", temporary_path)("f", _file_path) );
+  }
+
+}}} // namespace hive::plugins::sql_serializer
@@ -4,6 +4,9 @@
 #include <hive/plugins/sql_serializer/indexation_state.hpp>
 #include <hive/plugins/sql_serializer/queries_commit_data_processor.h>
 #include <hive/plugins/sql_serializer/accounts_collector.h>
+#include <hive/plugins/sql_serializer/impacted_accounts_extractor.hpp>
+#include <hive/plugins/sql_serializer/flush_tracer.hpp>
+#include <hive/plugins/sql_serializer/serializer_metrics.hpp>
 
 #include <hive/plugins/sql_serializer/data_processor.hpp>
 
@@ -25,6 +28,7 @@
 #include <fc/crypto/hex.hpp>
 #include <fc/utf8.hpp>
 
+#include <boost/asio/signal_set.hpp>
 #include <boost/filesystem.hpp>
 
 #include <condition_variable>
@@ -102,76 +106,22 @@ bool is_database_correct( const std::string& database_url, bool force_open_incon
   return true;
 }
 
-inline std::string get_operation_name(const hive::protocol::operation& op)
-{
-  PSQL::name_gathering_visitor v;
-  return op.visit(v);
-}
-
-using num_t = std::atomic<uint64_t>;
-using duration_t = fc::microseconds;
-using stat_time_t = std::atomic<duration_t>;
-
-struct stat_t
+DUMP_MODE get_dump_mode( const std::string& mode )
 {
-  stat_time_t processing_time{ duration_t{0} };
-  num_t count{0};
-};
+  if ( mode == "database" )
+    return DUMP_MODE::DATABASE;
+  if ( mode == "convert-only" )
+    return DUMP_MODE::CONVERT_ONLY;
+  if ( mode == "capture-only" )
+    return DUMP_MODE::CAPTURE_ONLY;
 
-struct ext_stat_t : public stat_t
-{
-  stat_time_t flush_time{ duration_t{0} };
-
-  void reset()
-  {
-    processing_time.store( duration_t{0} );
-    flush_time.store( duration_t{0} );
-    count.store(0);
-  }
-};
-
-struct stats_group
-{
-  stat_time_t sending_cache_time{ duration_t{0} };
-  uint64_t workers_count{0};
-  uint64_t all_created_workers{0};
-
-  ext_stat_t blocks{};
-  ext_stat_t transactions{};
-  ext_stat_t operations{};
-
-  void reset()
-  {
-    blocks.reset();
-    transactions.reset();
-    operations.reset();
-
-    sending_cache_time.store(duration_t{0});
-    workers_count = 0;
-    all_created_workers = 0;
-  }
-};
-
-inline std::ostream& operator<<(std::ostream& os, const stat_t& obj)
-{
-  return os << obj.processing_time.load().count() << " us | count: " << obj.count.load();
-}
-
-inline std::ostream& operator<<(std::ostream& os, const ext_stat_t& obj)
-{
-  return os << "flush time: " << obj.flush_time.load().count() << " us | processing time: " << obj.processing_time.load().count() << " us | count: " << obj.count.load();
+  FC_THROW( "Unknown value of 'psql-dump-mode': ${m}, expected one of: database, convert-only, capture-only", ("m", mode) );
 }
 
-inline std::ostream& operator<<(std::ostream& os, const stats_group& obj)
+inline std::string get_operation_name(const hive::protocol::operation& op)
 {
-  #define __shortcut( name ) << #name ": " << obj.name << std::endl
-  return os
-    << "threads created since last info: " << obj.all_created_workers << std::endl
-    << "currently working threads: " << obj.workers_count << std::endl
-    __shortcut(blocks)
-    __shortcut(transactions)
-    __shortcut(operations)
-    ;
+  PSQL::name_gathering_visitor v;
+  return op.visit(v);
 }
 
 using namespace hive::plugins::sql_serializer::PSQL;
@@ -198,15 +148,18 @@ public:
     , uint32_t _psql_index_threshold
     , uint32_t _psql_livesync_threshold
     , bool     _psql_enable_filter
+    , DUMP_MODE _dump_mode
   )
   : _indexation_state( _main_plugin, _chain_db, url,
                           _psql_transactions_threads_number,
                           _psql_operations_threads_number,
                           _psql_account_operations_threads_number,
                           _psql_index_threshold,
-                          _psql_livesync_threshold
+                          _psql_livesync_threshold,
+                          _dump_mode
                           ),
       db_url{url},
+      dump_mode{_dump_mode},
       chain_db{_chain_db},
       main_plugin{_main_plugin},
       psql_transactions_threads_number( _psql_transactions_threads_number ),
@@ -238,7 +191,7 @@ public:
 
   void handle_transactions(const vector<std::shared_ptr<hive::chain::full_transaction_type>>& transactions, const int64_t block_num);
   void inform_hfm_about_starting();
-  void collect_account_operations(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num);
+  void collect_account_operations(int64_t operation_id, const hive::protocol::operation& op, uint32_t block_num, int64_t trx_in_block, uint32_t op_in_trx, bool is_virtual);
 
   boost::signals2::connection _on_pre_apply_operation_con;
   std::unique_ptr< boost::signals2::shared_connection_block > _pre_apply_operation_blocker;
@@ -252,6 +205,7 @@ public:
   indexation_state _indexation_state;
 
   std::string db_url;
+  const DUMP_MODE dump_mode;
   hive::chain::database& chain_db;
   const sql_serializer_plugin& main_plugin;
 
@@ -270,14 +224,30 @@ public:
 
   cached_containter_t currently_caching_data;
   std::unique_ptr<accounts_collector> collector;
-  stats_group current_stats;
+  std::unique_ptr<impacted_accounts_extractor> impacted_extractor;
+  std::unique_ptr<metrics_file_writer> metrics_writer;
+  std::string trace_file;
+  std::unique_ptr<boost::asio::signal_set> trace_dump_signal;
+  fc::time_point block_apply_start;
   type_extractor::operation_extractor op_extractor;
   blockchain_filter filter;
 
+  void wait_for_trace_dump_signal()
+  {
+    trace_dump_signal->async_wait( [this]( const boost::system::error_code& ec, int )
+      {
+        if ( ec )
+          return;
+        tracer().dump( trace_file );
+        wait_for_trace_dump_signal();
+      } );
+  }
+
   void log_statistics()
   {
-    std::cout << current_stats;
-    current_stats.reset();
+    const auto& stats = metrics();
+    ilog( "Serializer statistics: blocks: ${b} operations: ${o} flushes: ${f} cached data: ${c} bytes",
+      ("b", stats.blocks.load())("o", stats.operations.load())("f", stats.flushes.load())("c", stats.cached_data_bytes.load()) );
   }
 
   auto get_switch_indexes_function( const std::string& query, bool mode, const std::string& objects_name ) {
@@ -300,6 +270,12 @@ public:
   {
     head_block_number = max_block_number;
 
+    if ( dump_mode != DUMP_MODE::DATABASE )
+    {
+      ilog( "Data are not dumped to the database, serialization starts from the first block" );
+      return;
+    }
+
     load_initial_db_data();
     if(freshDb)
     {
@@ -388,6 +364,9 @@ public:
 
 void sql_serializer_plugin_impl::inform_hfm_about_starting() {
   using namespace std::string_literals;
+  if ( dump_mode != DUMP_MODE::DATABASE )
+    return;
+
   ilog( "Inform Hive Fork Manager about starting..." );
 
   // inform the db about starting hivd
@@ -490,7 +469,7 @@ void sql_serializer_plugin_impl::on_pre_apply_operation(const operation_notifica
   const bool is_virtual = hive::protocol::is_virtual_operation(note.op);
   FC_ASSERT( is_virtual || note.trx_in_block >= 0,  "Non is_producing real operation with trx_in_block = -1" );
 
-  collect_account_operations( op_sequence_id, note.op, note.block );
+  collect_account_operations( op_sequence_id, note.op, note.block, note.trx_in_block, note.op_in_trx, is_virtual );
 
   if( collector->is_op_accepted() )
   {
@@ -508,6 +487,7 @@ void sql_serializer_plugin_impl::on_pre_apply_operation(const operation_notifica
       );
     }
 
+    ++metrics().operations;
     cdtf->operations.emplace_back(
       op_sequence_id,
       note.block,
@@ -522,6 +502,10 @@ void sql_serializer_plugin_impl::on_pre_apply_operation(const operation_notifica
 
 void sql_serializer_plugin_impl::on_post_apply_block(const block_notification& note)
 {
+  collector->on_block_end();
+  if( impacted_extractor )
+    impacted_extractor->finish_block();
+
   if(skip_reversible_block(note.block_num))
     return;
 
@@ -561,7 +545,12 @@ void sql_serializer_plugin_impl::on_post_apply_block(const block_notification& n
 
   _last_block_num = note.block_num;
 
+  ++metrics().blocks;
+  metrics().cached_data_bytes = currently_caching_data->total_size;
+
   _indexation_state.trigger_data_flush( *currently_caching_data, _last_block_num );
+  if ( currently_caching_data->blocks.empty() )
+    currently_caching_data->total_size = 0;
 
   filter.clear();
 
@@ -573,6 +562,11 @@ void sql_serializer_plugin_impl::on_post_apply_block(const block_notification& n
 
 void sql_serializer_plugin_impl::unblock_operation_handlers(const block_notification& note)
 {
+  if ( tracer().is_enabled() )
+    block_apply_start = fc::time_point::now();
+  collector->on_block_begin();
+  if( impacted_extractor && !skip_reversible_block( note.block_num ) )
+    impacted_extractor->start_block( note.full_block );
   _pre_apply_operation_blocker->unblock();
 }
 
@@ -583,6 +577,9 @@ void sql_serializer_plugin_impl::block_operation_handlers(const block_notificati
 
   /// block operations signals
   _pre_apply_operation_blocker->block();
+
+  if ( tracer().is_enabled() )
+    tracer().record( "apply block", nullptr, note.block_num, block_apply_start, fc::time_point::now() );
 }
 
 void sql_serializer_plugin_impl::handle_transactions(const vector<std::shared_ptr<hive::chain::full_transaction_type>>& transactions, const int64_t block_num)
@@ -691,9 +688,17 @@ void sql_serializer_plugin_impl::collect_account_operations(
     int64_t operation_id
   , const hive::protocol::operation& op
   , uint32_t block_num
+  , int64_t trx_in_block
+  , uint32_t op_in_trx
+  , bool is_virtual
 )
 {
-  collector->collect(operation_id, op, block_num);
+  // impacted accounts of virtual operations can't be found in advance, they are produced during the block application
+  const impacted_accounts_extractor::impacted_t* impacted = nullptr;
+  if( impacted_extractor && !is_virtual )
+    impacted = impacted_extractor->get( trx_in_block, op_in_trx );
+
+  collector->collect(operation_id, op, block_num, impacted);
 }
 
 } // namespace detail
@@ -709,29 +714,45 @@ void sql_serializer_plugin::set_program_options(appbase::options_description &cl
                     ("psql-operations-threads-number", appbase::bpo::value<uint32_t>()->default_value( 5 ), "number of threads which dump operations to database during reindexing")
                     ("psql-transactions-threads-number", appbase::bpo::value<uint32_t>()->default_value( 2 ), "number of threads which dump transactions to database during reindexing")
                     ("psql-account-operations-threads-number", appbase::bpo::value<uint32_t>()->default_value( 2 ), "number of threads which dump account operations to database during reindexing")
+                    ("psql-impacted-accounts-threads-number", appbase::bpo::value<uint32_t>()->default_value( 0 ), "number of threads which find accounts impacted by operations of a block before the block is applied, 0 - accounts are found by the chain thread")
                     ("psql-enable-account-operations-dump", appbase::bpo::value<bool>()->default_value( true ), "enable collect data to account_operations table")
                     ("psql-force-open-inconsistent", appbase::bpo::bool_switch()->default_value( false ), "force open database even when irreversible data are inconsistent")
                     ("psql-livesync-threshold", appbase::bpo::value<uint32_t>()->default_value( 100000 ), "threshold to move synchronization state during start immediatly to live")
                     ("psql-track-account-range", boost::program_options::value< std::vector<std::string> >()->composing()->multitoken(), "Defines a range of accounts to track as a json pair [\"from\",\"to\"] [from,to]. Can be specified multiple times.")
                     ("psql-track-operations", boost::program_options::value< std::vector<std::string> >()->composing(), "Defines operations' types to track. Can be specified multiple times.")
                     ("psql-track-body-operations", boost::program_options::value< std::vector<std::string> >()->composing()->multitoken(), "For a type of operation it's defined a regex that filters body of operation and decides if it's excluded. Can be specified multiple times. A complex regex can cause slowdown or processing can be even abandoned due to complexity.")
+                    ("psql-track-operation-predicates", boost::program_options::value< std::vector<std::string> >()->composing(), "Defines a predicate on a field of an operation, checked without converting the operation to JSON: `<operation>.<field> ==|prefix|in <JSON value>`, e.g. `custom_json_operation.id in [\"podping\",\"pp_video_update\"]`. Operations of types without predicates are excluded, like for psql-track-body-operations. Can be specified multiple times.")
                     ("psql-enable-filter", appbase::bpo::value<bool>()->default_value( true ), "enable filtering accounts and operations")
+                    ("psql-metrics-file", appbase::bpo::value<string>(), "path to a file where serializer metrics are periodically written in prometheus text format")
+                    ("psql-metrics-interval", appbase::bpo::value<uint32_t>()->default_value( 10 ), "how often, in seconds, the psql-metrics-file is rewritten")
+                    ("psql-trace-buffer-size", appbase::bpo::value<uint32_t>()->default_value( 0 ), "number of last flush pipeline spans kept in memory for tracing, 0 disables tracing")
+                    ("psql-trace-file", appbase::bpo::value<string>()->default_value( "sql_serializer_trace.json" ), "file where spans are dumped in Chrome trace-event JSON format on SIGUSR2 and at shutdown")
+                    ("psql-dump-mode", appbase::bpo::value<string>()->default_value( "database" ), "where collected data go: `database` - dump to the HAF database, `convert-only` - convert to SQL and discard, `capture-only` - discard without conversion. Both profiling modes do not need a database.")
                     ;
 }
 
 void sql_serializer_plugin::plugin_initialize(const boost::program_options::variables_map &options)
 {
   ilog("Initializing sql serializer plugin");
-  FC_ASSERT(options.count("psql-url"), "`psql-url` is required argument");
 
-  auto& db = appbase::app().get_plugin<hive::plugins::chain::chain_plugin>().db();
+  const auto dump_mode = get_dump_mode( options["psql-dump-mode"].as<fc::string>() );
+  std::string db_url;
+  if ( dump_mode == DUMP_MODE::DATABASE )
+  {
+    FC_ASSERT(options.count("psql-url"), "`psql-url` is required argument");
+    db_url = options["psql-url"].as<fc::string>();
 
-  FC_ASSERT( is_database_correct( options["psql-url"].as<fc::string>(), options["psql-force-open-inconsistent"].as<bool>() )
-              , "SQL database is in invalid state"
-  );
+    FC_ASSERT( is_database_correct( db_url, options["psql-force-open-inconsistent"].as<bool>() )
+                , "SQL database is in invalid state"
+    );
+  }
+  else
+    wlog( "Switch 'psql-dump-mode' was used, the sql_serializer works in profiling mode and nothing will be written to the database" );
+
+  auto& db = appbase::app().get_plugin<hive::plugins::chain::chain_plugin>().db();
 
   my = std::make_unique<detail::sql_serializer_plugin_impl>(
-    options["psql-url"].as<fc::string>()
+    db_url
     , db
     , *this
     , options["psql-operations-threads-number"].as<uint32_t>()
@@ -740,6 +761,7 @@ void sql_serializer_plugin::plugin_initialize(const boost::program_options::vari
     , options["psql-index-threshold"].as<uint32_t>()
     , options["psql-livesync-threshold"].as<uint32_t>()
     , options["psql-enable-filter"].as<bool>()
+    , dump_mode
   );
 
   // settings
@@ -748,13 +770,29 @@ void sql_serializer_plugin::plugin_initialize(const boost::program_options::vari
 
   my->currently_caching_data = std::make_unique<cached_data_t>( default_reservation_size );
 
-  my->filter.fill( options, "psql-track-account-range", "psql-track-operations", "psql-track-body-operations" );
+  my->filter.fill( options, "psql-track-account-range", "psql-track-operations", "psql-track-body-operations", "psql-track-operation-predicates" );
 
   if( my->filter.is_enabled() )
     my->collector = std::make_unique<filtered_accounts_collector>( db, *my->currently_caching_data, my->psql_dump_account_operations, my->filter );
   else
     my->collector = std::make_unique<accounts_collector>( db, *my->currently_caching_data, my->psql_dump_account_operations );
 
+  if ( options["psql-impacted-accounts-threads-number"].as<uint32_t>() > 0 )
+    my->impacted_extractor = std::make_unique<impacted_accounts_extractor>( options["psql-impacted-accounts-threads-number"].as<uint32_t>() );
+
+  if ( options.count( "psql-metrics-file" ) )
+    my->metrics_writer = std::make_unique<metrics_file_writer>( options["psql-metrics-file"].as<fc::string>(), options["psql-metrics-interval"].as<uint32_t>() );
+
+  if ( options["psql-trace-buffer-size"].as<uint32_t>() > 0 )
+  {
+    my->trace_file = options["psql-trace-file"].as<fc::string>();
+    tracer().enable( options["psql-trace-buffer-size"].as<uint32_t>() );
+    tracer().set_thread_name( "chain" );
+    my->trace_dump_signal = std::make_unique<boost::asio::signal_set>( appbase::app().get_io_service(), SIGUSR2 );
+    my->wait_for_trace_dump_signal();
+    ilog( "Send SIGUSR2 to dump sql_serializer trace to ${f}", ("f", my->trace_file) );
+  }
+
   // signals
   my->connect_signals();
 }
@@ -769,6 +807,13 @@ void sql_serializer_plugin::plugin_shutdown()
   ilog("Flushing left data...");
 
   my->disconnect_signals();
+  my->impacted_extractor.reset();
+  my->metrics_writer.reset();
+  if ( my->trace_dump_signal )
+  {
+    my->trace_dump_signal->cancel();
+    tracer().dump( my->trace_file );
+  }
 
   ilog("Done. Connection closed");
 }
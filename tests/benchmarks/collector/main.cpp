@@ -0,0 +1,206 @@
+#include <hive/plugins/sql_serializer/accounts_collector.h>
+#include <hive/plugins/sql_serializer/cached_data.h>
+#include <hive/plugins/sql_serializer/sql_serializer_objects.hpp>
+
+#include <hive/chain/database.hpp>
+#include <hive/chain/index.hpp>
+#include <hive/protocol/config.hpp>
+#include <hive/utilities/database_configuration.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace {
+
+  namespace sql = hive::plugins::sql_serializer;
+  using hive::protocol::account_name_type;
+
+  /// accounts created by the genesis, every operation of the benchmark impacts some of them, like operations of exchanges do
+  const std::vector< account_name_type > hot_accounts{ HIVE_INIT_MINER_NAME, HIVE_MINER_ACCOUNT, HIVE_NULL_ACCOUNT, HIVE_TEMP_ACCOUNT };
+
+  struct benchmark_result
+  {
+    uint64_t operations = 0;
+    uint64_t account_operations = 0;
+    double   seconds = 0.0;
+  };
+
+  /// transfers between hot accounts and custom_jsons signed by all of them, so each operation impacts 2-4 accounts
+  std::vector< std::vector< hive::protocol::operation > > generate_blocks( uint32_t blocks, uint32_t operations_per_block, uint32_t seed )
+  {
+    std::mt19937 random( seed );
+    std::uniform_int_distribution< size_t > account( 0, hot_accounts.size() - 1 );
+    std::vector< std::vector< hive::protocol::operation > > result( blocks );
+
+    for ( auto& block : result )
+    {
+      block.reserve( operations_per_block );
+      for ( uint32_t i = 0; i < operations_per_block; ++i )
+      {
+        if ( i % 2 )
+        {
+          hive::protocol::transfer_operation transfer;
+          transfer.from = hot_accounts[ account( random ) ];
+          transfer.to = hot_accounts[ account( random ) ];
+          block.emplace_back( transfer );
+        }
+        else
+        {
+          hive::protocol::custom_json_operation custom_json;
+          custom_json.id = "benchmark";
+          custom_json.json = "{}";
+          custom_json.required_posting_auths.insert( hot_accounts.begin(), hot_accounts.end() );
+          block.emplace_back( custom_json );
+        }
+      }
+    }
+
+    return result;
+  }
+
+  benchmark_result measure( hive::chain::database& chain_db, const std::vector< std::vector< hive::protocol::operation > >& blocks, bool undo_sessions )
+  {
+    benchmark_result result;
+    sql::cached_data_t cached_data( 1 );
+    sql::accounts_collector collector( chain_db, cached_data, true );
+    int64_t operation_id = 0;
+    uint32_t block_num = 1;
+
+    auto collect_block = [&]( const std::vector< hive::protocol::operation >& block )
+    {
+      collector.on_block_begin();
+      for ( const auto& op : block )
+        collector.collect( operation_id++, op, block_num );
+      collector.on_block_end();
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    chain_db.with_write_lock( [&]()
+    {
+      for ( const auto& block : blocks )
+      {
+        // the collector works inside of undo sessions of blocks when hived is live
+        if ( undo_sessions )
+        {
+          auto session = chain_db.start_undo_session();
+          collect_block( block );
+          session.push();
+          chain_db.commit( chain_db.revision() );
+        }
+        else
+          collect_block( block );
+
+        result.operations += block.size();
+        result.account_operations += cached_data.account_operations.size();
+        cached_data.account_operations.clear();
+        ++block_num;
+      }
+    } );
+    result.seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    return result;
+  }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Measures cost of accounts_collector::collect on blocks whose operations impact the same few accounts, prints a JSON object" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "blocks,b", po::value< uint32_t >()->default_value( 1000 ), "number of blocks" )
+    ( "operations,n", po::value< uint32_t >()->default_value( 2000 ), "number of operations in each block" )
+    ( "seed,s", po::value< uint32_t >()->default_value( 42 ), "seed of the operations generator" )
+    ( "no-undo-sessions", po::bool_switch()->default_value( false ), "collect without undo sessions of blocks, like during replay" )
+    ( "output,o", po::value< std::string >(), "file to write results to, stdout when not set" )
+    ;
+
+  const auto shared_memory_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "collector-benchmark-%%%%-%%%%" );
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    const auto blocks_number = args[ "blocks" ].as< uint32_t >();
+    const auto operations_per_block = args[ "operations" ].as< uint32_t >();
+    const bool undo_sessions = !args[ "no-undo-sessions" ].as< bool >();
+    FC_ASSERT( blocks_number > 0 && operations_per_block > 0, "Number of blocks and operations must be positive" );
+
+    const auto blocks = generate_blocks( blocks_number, operations_per_block, args[ "seed" ].as< uint32_t >() );
+
+    hive::chain::database chain_db;
+    HIVE_ADD_PLUGIN_INDEX( chain_db, sql::account_ops_seq_index );
+
+    hive::chain::open_args open_args;
+    open_args.data_dir = shared_memory_dir;
+    open_args.shared_mem_dir = shared_memory_dir;
+    open_args.shared_file_size = 256 * 1024 * 1024;
+    open_args.database_cfg = hive::utilities::default_database_configuration();
+    chain_db.open( open_args );
+
+    chain_db.with_write_lock( [&]()
+    {
+      for ( const auto& name : hot_accounts )
+      {
+        const auto* account = chain_db.find_account( name );
+        FC_ASSERT( account != nullptr, "Genesis did not create account ${a}", ("a", name) );
+        chain_db.create< sql::account_ops_seq_object >( *account );
+      }
+    } );
+
+    const auto result = measure( chain_db, blocks, undo_sessions );
+    chain_db.close();
+
+    std::ofstream output_file;
+    if ( args.count( "output" ) )
+    {
+      output_file.open( args[ "output" ].as< std::string >() );
+      FC_ASSERT( output_file.is_open(), "Cannot open output file ${f}", ("f", args[ "output" ].as< std::string >()) );
+    }
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    const double seconds = result.seconds > 0.0 ? result.seconds : 1e-9;
+    output << fc::json::to_string( fc::mutable_variant_object()
+      ( "benchmark", undo_sessions ? "collect/undo_sessions" : "collect/no_undo_sessions" )
+      ( "blocks", blocks_number )
+      ( "operations", result.operations )
+      ( "account_operations", result.account_operations )
+      ( "seconds", result.seconds )
+      ( "ns_per_operation", seconds * 1e9 / result.operations )
+      ( "operations_per_s", result.operations / seconds )
+    ) << '\n';
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Benchmark failed: ${e}", ( "e", e.to_detail_string() ) );
+    boost::filesystem::remove_all( shared_memory_dir );
+    return 1;
+  }
+
+  boost::filesystem::remove_all( shared_memory_dir );
+  return 0;
+}
@@ -0,0 +1,185 @@
+#include <corpus.hpp>
+
+#include <hive/plugins/sql_serializer/tables_descriptions.h>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace {
+
+  namespace sql = hive::plugins::sql_serializer;
+  using block_generator::objects::process_operation_t;
+
+  struct benchmark_result
+  {
+    std::string name;
+    uint64_t    rows = 0;
+    uint64_t    bytes = 0;
+    double      seconds = 0.0;
+  };
+
+  /// escape kernels are protected in data2_sql_tuple_base, converters use them through inheritance
+  struct escape_kernels : public sql::data2_sql_tuple_base
+  {
+    using data2_sql_tuple_base::escape;
+    using data2_sql_tuple_base::escape_raw;
+  };
+
+  /// bytes are sizes of produced strings, the rows are converted `iterations` times
+  template< typename Rows, typename Kernel >
+  benchmark_result measure( const std::string& name, const Rows& rows, uint32_t iterations, Kernel&& kernel )
+  {
+    benchmark_result result{ name };
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( uint32_t iteration = 0; iteration < iterations; ++iteration )
+    {
+      for ( const auto& row : rows )
+        result.bytes += kernel( row ).size();
+    }
+    result.seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    result.rows = static_cast< uint64_t >( rows.size() ) * iterations;
+
+    return result;
+  }
+
+  template< typename TableDescriptor >
+  benchmark_result measure_converter( const std::string& name, const typename TableDescriptor::container_t& rows, uint32_t iterations )
+  {
+    typename TableDescriptor::data2sql_tuple converter;
+    return measure( name, rows, iterations, [&converter]( const auto& row ) { return converter( row ); } );
+  }
+
+  std::string to_json( const benchmark_result& result, uint32_t blocks, uint32_t iterations )
+  {
+    const double seconds = result.seconds > 0.0 ? result.seconds : 1e-9;
+
+    return fc::json::to_string( fc::mutable_variant_object()
+      ( "benchmark", result.name )
+      ( "blocks", blocks )
+      ( "iterations", iterations )
+      ( "rows", result.rows )
+      ( "bytes", result.bytes )
+      ( "seconds", result.seconds )
+      ( "rows_per_s", result.rows / seconds )
+      ( "bytes_per_s", result.bytes / seconds )
+    );
+  }
+
+  std::vector< benchmark_result > run_benchmarks( const block_generator::corpus& corpus, uint32_t iterations, bool by_operation_type )
+  {
+    using operations_t = std::vector< process_operation_t >;
+    using transactions_t = std::vector< block_generator::objects::process_transaction_t >;
+    using account_operations_t = std::vector< block_generator::objects::account_operation_data_t >;
+
+    std::vector< benchmark_result > results;
+
+    results.push_back( measure_converter< sql::hive_blocks >( "insert/hive.blocks", corpus.blocks, iterations ) );
+    results.push_back( measure_converter< sql::hive_transactions< transactions_t > >( "insert/hive.transactions", corpus.transactions, iterations ) );
+    results.push_back( measure_converter< sql::hive_transactions_multisig >( "insert/hive.transactions_multisig", corpus.transactions_multisig, iterations ) );
+    results.push_back( measure_converter< sql::hive_operations< operations_t > >( "insert/hive.operations", corpus.operations, iterations ) );
+    results.push_back( measure_converter< sql::hive_accounts >( "insert/hive.accounts", corpus.accounts, iterations ) );
+    results.push_back( measure_converter< sql::hive_account_operations< account_operations_t > >( "insert/hive.account_operations", corpus.account_operations, iterations ) );
+    results.push_back( measure_converter< sql::hive_applied_hardforks >( "insert/hive.applied_hardforks", corpus.applied_hardforks, iterations ) );
+
+    escape_kernels kernels;
+    std::vector< fc::ripemd160 > hashes;
+    for ( const auto& block : corpus.blocks )
+      hashes.push_back( block.hash );
+    std::vector< std::vector< char > > bodies;
+    for ( const auto& operation : corpus.operations )
+      bodies.push_back( fc::raw::pack_to_vector( operation.op ) );
+
+    results.push_back( measure( "escape/text", corpus.texts, iterations, [&kernels]( const std::string& text ) { return kernels.escape( text ); } ) );
+    results.push_back( measure( "escape_raw/hash", hashes, iterations, [&kernels]( const fc::ripemd160& hash ) { return kernels.escape_raw( hash ); } ) );
+    results.push_back( measure( "escape_raw/binary", bodies, iterations, [&kernels]( const std::vector< char >& body ) { return kernels.escape_raw( body ); } ) );
+    results.push_back( measure( "pack/operation", corpus.operations, iterations, []( const process_operation_t& operation ) { return fc::raw::pack_to_vector( operation.op ); } ) );
+
+    if ( by_operation_type )
+    {
+      std::map< int64_t, operations_t > operations_by_type;
+      for ( const auto& operation : corpus.operations )
+        operations_by_type[ operation.op.which() ].push_back( operation );
+
+      for ( const auto& operations : operations_by_type )
+      {
+        const auto name = block_generator::operation_name( operations.second.front().op );
+        results.push_back( measure_converter< sql::hive_operations< operations_t > >( "insert/hive.operations/" + name, operations.second, iterations ) );
+      }
+    }
+
+    return results;
+  }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Measures speed of conversion of sql_serializer rows to SQL, prints one JSON object per line" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "blocks,b", po::value< uint32_t >()->default_value( 2000 ), "number of synthetic blocks in the corpus" )
+    ( "iterations,i", po::value< uint32_t >()->default_value( 5 ), "how many times each converter processes the whole corpus" )
+    ( "seed,s", po::value< uint32_t >()->default_value( 42 ), "seed of the corpus generator" )
+    ( "profile,p", po::value< std::string >(), "JSON file with a block_generator profile, the mainnet profile when not set" )
+    ( "operation-types,t", po::bool_switch()->default_value( false ), "additionally measure hive.operations converter for each operation type" )
+    ( "output,o", po::value< std::string >(), "file to write results to, stdout when not set" )
+    ;
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    const auto blocks = args[ "blocks" ].as< uint32_t >();
+    const auto iterations = args[ "iterations" ].as< uint32_t >();
+    FC_ASSERT( blocks > 0 && iterations > 0, "Number of blocks and iterations must be positive" );
+
+    const auto profile = args.count( "profile" ) ? block_generator::load_profile( args[ "profile" ].as< std::string >() ) : block_generator::mainnet_profile();
+    const auto corpus = block_generator::generate_corpus( profile, blocks, args[ "seed" ].as< uint32_t >() );
+    ilog( "Corpus: ${b} blocks, ${t} transactions, ${o} operations, ${ao} account operations"
+      , ("b", corpus.blocks.size())("t", corpus.transactions.size())("o", corpus.operations.size())("ao", corpus.account_operations.size()) );
+
+    const auto results = run_benchmarks( corpus, iterations, args[ "operation-types" ].as< bool >() );
+
+    std::ofstream output_file;
+    if ( args.count( "output" ) )
+    {
+      output_file.open( args[ "output" ].as< std::string >() );
+      FC_ASSERT( output_file.is_open(), "Cannot open output file ${f}", ("f", args[ "output" ].as< std::string >()) );
+    }
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    for ( const auto& result : results )
+      output << to_json( result, blocks, iterations ) << '\n';
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Benchmark failed: ${e}", ( "e", e.to_detail_string() ) );
+    return 1;
+  }
+
+  return 0;
+}
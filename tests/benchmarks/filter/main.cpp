@@ -0,0 +1,311 @@
+#include <blocks_generator.hpp>
+
+#include <hive/plugins/sql_serializer/blockchain_data_filter.hpp>
+#include <hive/plugins/sql_serializer/filter_collector.hpp>
+
+#include <hive/chain/util/impacted.hpp>
+#include <hive/chain/util/operation_extractor.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+
+namespace hive::plugins::sql_serializer {
+
+  namespace {
+
+    /// the filter as it was before compilation of accounts ranges, operations' types and accepted transactions
+    struct legacy_blockchain_filter: public blockchain_data_filter
+    {
+      bool                                    enabled = true;
+      std::set<int64_t>                       trx_in_block_filter_accepted;
+      operation_helper                        op_helper;
+      std::unique_ptr<account_filter>         accounts_filter_tracker;
+      std::unique_ptr<operation_filter>       operations_filter_tracker;
+      std::unique_ptr<operation_body_filter>  operations_body_filter_tracker;
+
+      legacy_blockchain_filter( const type_extractor::operation_extractor& op_extractor ): op_helper( op_extractor ) {}
+
+      bool is_enabled() const override { return enabled; }
+      bool is_trx_accepted( int64_t trx_in_block ) const { return trx_in_block_filter_accepted.find( trx_in_block ) != trx_in_block_filter_accepted.end(); }
+
+      bool is_tracked_account( const account_name_type& name ) const override
+      {
+        return !accounts_filter_tracker || accounts_filter_tracker->is_tracked_account( name );
+      }
+
+      bool is_tracked_operation( const operation& op ) const override
+      {
+        return ( !operations_filter_tracker       ||  operations_filter_tracker->is_tracked_operation( op ) ) &&
+               ( !operations_body_filter_tracker  ||  operations_body_filter_tracker->is_tracked_operation( op ) );
+      }
+
+      void remember_trx_id( int64_t trx_in_block )
+      {
+        if( trx_in_block != -1 )
+          trx_in_block_filter_accepted.insert( trx_in_block );
+      }
+
+      void fill( const boost::program_options::variables_map& options )
+      {
+        auto _af  = std::make_unique<account_filter>( "acc-sql" );
+        auto _of  = std::make_unique<operation_filter>( "op-sql", op_helper );
+        auto _obf = std::make_unique<operation_body_filter>( "opb-sql", op_helper );
+
+        _af->fill( options, "psql-track-account-range" );
+        _of->fill( options, "psql-track-operations" );
+        _obf->fill( options, "psql-track-body-operations" );
+
+        if( !_af->empty() )
+          accounts_filter_tracker = std::move( _af );
+        if( !_of->empty() )
+          operations_filter_tracker = std::move( _of );
+        if( !_obf->empty() )
+          operations_body_filter_tracker = std::move( _obf );
+      }
+
+      void clear() { trx_in_block_filter_accepted.clear(); }
+    };
+
+  } // namespace
+
+} // namespace hive::plugins::sql_serializer
+
+namespace {
+
+  namespace sql = hive::plugins::sql_serializer;
+  using hive::protocol::account_name_type;
+
+  /// the default filter resembles configurations from tests/integration/replay/patterns
+  const char* default_filter_config = R"(
+psql-track-account-range = ["b","back"]
+psql-track-account-range = ["root","root"]
+psql-track-account-range = ["gtg","gtg"]
+psql-track-account-range = ["hive.fund","hive.fund"]
+psql-track-operations = vote_operation
+psql-track-operations = transfer_operation
+psql-track-operations = comment_operation
+psql-track-operations = author_reward_operation
+psql-track-operations = curation_reward_operation
+psql-track-operations = producer_reward_operation
+psql-track-operations = fill_order_operation
+)";
+
+  struct filtered_operation
+  {
+    hive::protocol::operation               op;
+    int64_t                                 trx_in_block = -1;
+    std::vector< account_name_type >        impacted;
+  };
+
+  struct filtered_block
+  {
+    std::vector< filtered_operation > operations;
+    uint32_t                          transactions = 0;
+  };
+
+  struct benchmark_result
+  {
+    std::string name;
+    uint64_t    operations = 0;
+    uint64_t    accepted_operations = 0;
+    uint64_t    accepted_account_operations = 0;
+    uint64_t    accepted_transactions = 0;
+    double      seconds = 0.0;
+  };
+
+  std::vector< filtered_block > generate_blocks( const block_generator::generator_profile& profile, uint32_t blocks, uint32_t seed )
+  {
+    block_generator::blocks_generator generator( profile, seed, 1 );
+    std::vector< filtered_block > result;
+    result.reserve( blocks );
+
+    boost::container::flat_set< account_name_type > impacted;
+    auto add_operation = [&impacted]( filtered_block& block, const hive::protocol::operation& op, int64_t trx_in_block )
+    {
+      impacted.clear();
+      hive::app::operation_get_impacted_accounts( op, impacted );
+      block.operations.push_back( { op, trx_in_block, { impacted.begin(), impacted.end() } } );
+    };
+
+    for ( uint32_t i = 0; i < blocks; ++i )
+    {
+      const auto generated = generator.next_block();
+      filtered_block block;
+      block.transactions = generated.block.transactions.size();
+
+      for ( size_t trx_in_block = 0; trx_in_block < generated.block.transactions.size(); ++trx_in_block )
+        for ( const auto& op : generated.block.transactions[ trx_in_block ].operations )
+          add_operation( block, op, trx_in_block );
+      for ( const auto& op : generated.virtual_operations )
+        add_operation( block, op, -1 );
+
+      result.push_back( std::move( block ) );
+    }
+
+    return result;
+  }
+
+  /// does for each operation what sql_serializer does with filtering enabled: filtered_accounts_collector and then transactions' check
+  template< typename Filter >
+  benchmark_result measure( const std::string& name, Filter& filter, const std::vector< filtered_block >& blocks, uint32_t iterations )
+  {
+    benchmark_result result{ name };
+
+    const auto start = std::chrono::steady_clock::now();
+    for ( uint32_t iteration = 0; iteration < iterations; ++iteration )
+    {
+      sql::filter_collector collector( filter );
+
+      for ( const auto& block : blocks )
+      {
+        filter.clear();
+
+        for ( const auto& operation : block.operations )
+        {
+          collector.collect_tracked_operation( operation.op );
+          for ( const auto& account : operation.impacted )
+            collector.collect_tracked_account( account );
+          for ( const auto& account : operation.impacted )
+            result.accepted_account_operations += collector.is_account_tracked( account ) && collector.is_operation_tracked( true );
+
+          if ( collector.is_op_accepted() )
+          {
+            filter.remember_trx_id( operation.trx_in_block );
+            ++result.accepted_operations;
+          }
+        }
+
+        for ( uint32_t trx_in_block = 0; trx_in_block < block.transactions; ++trx_in_block )
+          result.accepted_transactions += filter.is_trx_accepted( trx_in_block );
+
+        result.operations += block.operations.size();
+      }
+    }
+    result.seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    return result;
+  }
+
+  std::string to_json( const benchmark_result& result, uint32_t blocks, uint32_t iterations )
+  {
+    const double operations = result.operations > 0 ? result.operations : 1;
+
+    return fc::json::to_string( fc::mutable_variant_object()
+      ( "benchmark", result.name )
+      ( "blocks", blocks )
+      ( "iterations", iterations )
+      ( "operations", result.operations )
+      ( "accepted_operations", result.accepted_operations )
+      ( "accepted_account_operations", result.accepted_account_operations )
+      ( "accepted_transactions", result.accepted_transactions )
+      ( "seconds", result.seconds )
+      ( "ns_per_operation", result.seconds * 1e9 / operations )
+    );
+  }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Measures cost of sql_serializer filtering per operation, prints one JSON object per line" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "blocks,b", po::value< uint32_t >()->default_value( 2000 ), "number of synthetic blocks" )
+    ( "iterations,i", po::value< uint32_t >()->default_value( 5 ), "how many times each filter processes all blocks" )
+    ( "seed,s", po::value< uint32_t >()->default_value( 42 ), "seed of the blocks generator" )
+    ( "profile,p", po::value< std::string >(), "JSON file with a block_generator profile, the mainnet profile when not set" )
+    ( "filter-config,f", po::value< std::string >(), "hived config file with psql-track-* options, a few account ranges and popular operations when not set" )
+    ( "output,o", po::value< std::string >(), "file to write results to, stdout when not set" )
+    ;
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    const auto blocks_number = args[ "blocks" ].as< uint32_t >();
+    const auto iterations = args[ "iterations" ].as< uint32_t >();
+    FC_ASSERT( blocks_number > 0 && iterations > 0, "Number of blocks and iterations must be positive" );
+
+    po::options_description filter_options;
+    filter_options.add_options()
+      ( "psql-track-account-range", po::value< std::vector< std::string > >()->composing()->multitoken(), "" )
+      ( "psql-track-operations", po::value< std::vector< std::string > >()->composing(), "" )
+      ( "psql-track-body-operations", po::value< std::vector< std::string > >()->composing()->multitoken(), "" );
+
+    po::variables_map filter_args;
+    if ( args.count( "filter-config" ) )
+    {
+      std::ifstream config( args[ "filter-config" ].as< std::string >() );
+      FC_ASSERT( config.is_open(), "Cannot open filter config ${f}", ("f", args[ "filter-config" ].as< std::string >()) );
+      po::store( po::parse_config_file( config, filter_options, true ), filter_args );
+    }
+    else
+    {
+      std::stringstream config( default_filter_config );
+      po::store( po::parse_config_file( config, filter_options, true ), filter_args );
+    }
+
+    const auto profile = args.count( "profile" ) ? block_generator::load_profile( args[ "profile" ].as< std::string >() ) : block_generator::mainnet_profile();
+    const auto blocks = generate_blocks( profile, blocks_number, args[ "seed" ].as< uint32_t >() );
+
+    type_extractor::operation_extractor op_extractor;
+
+    sql::legacy_blockchain_filter legacy( op_extractor );
+    legacy.fill( filter_args );
+
+    sql::blockchain_filter compiled( true, op_extractor );
+    compiled.fill( filter_args, "psql-track-account-range", "psql-track-operations", "psql-track-body-operations", "psql-track-operation-predicates" );
+    FC_ASSERT( compiled.is_enabled(), "Filter config does not contain any psql-track-* option" );
+
+    const auto legacy_result = measure( "filter/legacy", legacy, blocks, iterations );
+    const auto compiled_result = measure( "filter/compiled", compiled, blocks, iterations );
+
+    FC_ASSERT( legacy_result.accepted_operations == compiled_result.accepted_operations
+      && legacy_result.accepted_account_operations == compiled_result.accepted_account_operations
+      && legacy_result.accepted_transactions == compiled_result.accepted_transactions,
+      "Filters accepted different data: legacy ${l}, compiled ${c}", ("l", to_json( legacy_result, blocks_number, iterations ))("c", to_json( compiled_result, blocks_number, iterations )) );
+
+    std::ofstream output_file;
+    if ( args.count( "output" ) )
+    {
+      output_file.open( args[ "output" ].as< std::string >() );
+      FC_ASSERT( output_file.is_open(), "Cannot open output file ${f}", ("f", args[ "output" ].as< std::string >()) );
+    }
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    output << to_json( legacy_result, blocks_number, iterations ) << '\n';
+    output << to_json( compiled_result, blocks_number, iterations ) << '\n';
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Benchmark failed: ${e}", ( "e", e.to_detail_string() ) );
+    return 1;
+  }
+
+  return 0;
+}
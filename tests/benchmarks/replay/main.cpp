@@ -0,0 +1,105 @@
+#include "replay_benchmark.hpp"
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+  std::string to_json( const benchmarks::mode_result& result )
+  {
+    const double seconds = result.seconds > 0.0 ? result.seconds : 1e-9;
+
+    return fc::json::to_string( fc::mutable_variant_object()
+      ( "mode", result.mode )
+      ( "blocks", result.blocks )
+      ( "rows", result.rows )
+      ( "seconds", result.seconds )
+      ( "generation_seconds", result.generation_seconds )
+      ( "blocks_per_s", result.blocks / seconds )
+      ( "rows_per_s", result.rows / seconds )
+      ( "peak_rss_kb", result.peak_rss_kb )
+    );
+  }
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  namespace po = boost::program_options;
+
+  po::options_description options( "Replays synthetic blocks through sql_serializer dumpers into a fresh HAF database, prints one JSON object per sync mode" );
+  options.add_options()
+    ( "help,h", "Print this help message and exit" )
+    ( "url,u", po::value< std::string >()->required(), "postgres connection string to a fresh HAF database, e.g. `dbname=haf_benchmark'" )
+    ( "blocks,b", po::value< uint32_t >()->default_value( 10000 ), "number of blocks replayed in each of REINDEX, P2P and LIVE modes" )
+    ( "seed,s", po::value< uint32_t >()->default_value( 42 ), "seed of the blocks generator" )
+    ( "profile,p", po::value< std::string >(), "JSON file with a block_generator profile, the mainnet profile when not set" )
+    ( "transactions-threads", po::value< uint32_t >()->default_value( 2 ), "the same as psql-transactions-threads-number of sql_serializer" )
+    ( "operations-threads", po::value< uint32_t >()->default_value( 5 ), "the same as psql-operations-threads-number of sql_serializer" )
+    ( "account-operations-threads", po::value< uint32_t >()->default_value( 2 ), "the same as psql-account-operations-threads-number of sql_serializer" )
+    ( "index-threshold", po::value< uint32_t >()->default_value( 1'000'000 ), "the same as psql-index-threshold of sql_serializer, indexes are dropped when 2 * blocks is greater" )
+    ( "reversible-blocks", po::value< uint32_t >()->default_value( 21 ), "distance between head and the last irreversible block in P2P and LIVE modes" )
+    ( "output,o", po::value< std::string >(), "file to write results to, stdout when not set" )
+    ;
+
+  try
+  {
+    po::variables_map args;
+    po::store( po::parse_command_line( argc, argv, options ), args );
+    if ( args.count( "help" ) )
+    {
+      std::cout << options << std::endl;
+      return 0;
+    }
+    po::notify( args );
+
+    benchmarks::replay_options replay_options;
+    replay_options.db_url = args[ "url" ].as< std::string >();
+    replay_options.blocks_per_mode = args[ "blocks" ].as< uint32_t >();
+    replay_options.seed = args[ "seed" ].as< uint32_t >();
+    replay_options.profile = args.count( "profile" ) ? block_generator::load_profile( args[ "profile" ].as< std::string >() ) : block_generator::mainnet_profile();
+    replay_options.transactions_threads = args[ "transactions-threads" ].as< uint32_t >();
+    replay_options.operations_threads = args[ "operations-threads" ].as< uint32_t >();
+    replay_options.account_operations_threads = args[ "account-operations-threads" ].as< uint32_t >();
+    replay_options.index_threshold = args[ "index-threshold" ].as< uint32_t >();
+    replay_options.reversible_blocks = args[ "reversible-blocks" ].as< uint32_t >();
+    FC_ASSERT( replay_options.blocks_per_mode > replay_options.reversible_blocks, "Number of blocks must be greater than number of reversible blocks" );
+
+    const auto results = benchmarks::replay_benchmark( replay_options ).run();
+
+    std::ofstream output_file;
+    if ( args.count( "output" ) )
+    {
+      output_file.open( args[ "output" ].as< std::string >() );
+      FC_ASSERT( output_file.is_open(), "Cannot open output file ${f}", ("f", args[ "output" ].as< std::string >()) );
+    }
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    for ( const auto& result : results )
+      output << to_json( result ) << '\n';
+  }
+  catch ( const po::error& e )
+  {
+    std::cerr << e.what() << std::endl << options << std::endl;
+    return 1;
+  }
+  catch ( const fc::exception& e )
+  {
+    elog( "Benchmark failed: ${e}", ( "e", e.to_detail_string() ) );
+    return 1;
+  }
+  catch ( const std::exception& e )
+  {
+    elog( "Benchmark failed: ${e}", ( "e", e.what() ) );
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,233 @@
+#include "replay_benchmark.hpp"
+
+#include <hive/plugins/sql_serializer/indexation_state.hpp>
+#include <hive/plugins/sql_serializer/livesync_data_dumper.h>
+#include <hive/plugins/sql_serializer/queries_commit_data_processor.h>
+#include <hive/plugins/sql_serializer/reindex_data_dumper.h>
+#include <hive/plugins/sql_serializer/sql_serializer_plugin.hpp>
+
+#include <transactions_controller/transaction_controllers.hpp>
+
+#include <hive/chain/database.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+
+#include <fstream>
+#include <iterator>
+
+namespace benchmarks {
+
+namespace {
+
+  namespace sql = hive::plugins::sql_serializer;
+
+  template< typename Item >
+  uint64_t append_rows( std::vector< Item >& target, std::vector< Item >& source )
+  {
+    target.insert( target.end(), std::make_move_iterator( source.begin() ), std::make_move_iterator( source.end() ) );
+    return source.size();
+  }
+
+  /// resets the peak resident set size of the process, supported by Linux since 4.0
+  void reset_peak_rss()
+  {
+    std::ofstream clear_refs( "/proc/self/clear_refs" );
+    clear_refs << "5";
+  }
+
+  uint64_t peak_rss_kb()
+  {
+    std::ifstream status( "/proc/self/status" );
+    std::string line;
+    while ( std::getline( status, line ) )
+    {
+      if ( line.compare( 0, 6, "VmHWM:" ) == 0 )
+        return std::stoull( line.substr( 6 ) );
+    }
+    return 0;
+  }
+
+  double seconds_since( const std::chrono::steady_clock::time_point& start )
+  {
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+  }
+
+} // namespace
+
+replay_benchmark::replay_benchmark( replay_options options )
+  : _options( std::move( options ) )
+  , _generator( _options.profile, _options.seed, 1 )
+  , _indexes_controler( _options.db_url, _options.index_threshold )
+{
+}
+
+std::vector< mode_result > replay_benchmark::run()
+{
+  prepare_database();
+
+  std::vector< mode_result > results;
+  results.push_back( run_reindex() );
+  results.push_back( run_p2p() );
+  results.push_back( restore_indexes() );
+  results.push_back( run_live() );
+  return results;
+}
+
+void replay_benchmark::prepare_database()
+{
+  auto tx_controller = transaction_controllers::build_own_transaction_controller( _options.db_url, "Replay benchmark" );
+  auto tx = tx_controller->openTx();
+  const pqxx::result blocks = tx->exec( "SELECT COUNT(*) FROM hive.blocks" );
+  FC_ASSERT( blocks[ 0 ][ 0 ].as< uint64_t >() == 0, "Replay benchmark requires a fresh HAF database, but hive.blocks is not empty" );
+
+  tx->exec( "SELECT hive.connect('replay_benchmark', 0)" );
+  tx->exec( sql::PSQL::get_all_type_definitions( type_extractor::operation_extractor() ) );
+  tx->commit();
+}
+
+mode_result replay_benchmark::run_reindex()
+{
+  ilog( "Replay benchmark: REINDEX of ${b} blocks", ("b", _options.blocks_per_mode) );
+  mode_result result{ "REINDEX" };
+  reset_peak_rss();
+  const auto start = clock::now();
+
+  _indexes_controler.disable_constraints();
+  // indexes stay disabled for P2P sync too, like when hived syncs from p2p after replay
+  _indexes_controler.disable_indexes_depends_on_blocks( 2 * _options.blocks_per_mode );
+  {
+    sql::reindex_data_dumper dumper( _options.db_url, _options.operations_threads, _options.transactions_threads, _options.account_operations_threads );
+    sql::cached_data_t cached_data( sql::prereservation_size );
+
+    for ( uint32_t i = 0; i < _options.blocks_per_mode; ++i )
+    {
+      const auto block_num = append_block( cached_data, result );
+      if ( sql::indexation_state::is_reindex_flush_needed( block_num ) )
+        dumper.trigger_data_flush( cached_data, block_num );
+    }
+
+    if ( !cached_data.blocks.empty() )
+      dumper.trigger_data_flush( cached_data, cached_data.blocks.back().block_number );
+  } // the dumper waits for writers and ends massive sync
+
+  result.seconds = seconds_since( start );
+  result.peak_rss_kb = peak_rss_kb();
+  return result;
+}
+
+mode_result replay_benchmark::run_p2p()
+{
+  ilog( "Replay benchmark: P2P sync of ${b} blocks", ("b", _options.blocks_per_mode) );
+  mode_result result{ "P2P" };
+  reset_peak_rss();
+  const auto start = clock::now();
+  {
+    sql::reindex_data_dumper dumper( _options.db_url, _options.operations_threads, _options.transactions_threads, _options.account_operations_threads );
+    sql::cached_data_t cached_data( sql::prereservation_size );
+    int32_t last_flushed_block = _generator.next_block() - 1;
+
+    for ( uint32_t i = 0; i < _options.blocks_per_mode; ++i )
+    {
+      const auto block_num = append_block( cached_data, result );
+      const int32_t irreversible_block = block_num - static_cast< int32_t >( _options.reversible_blocks );
+      if ( !sql::indexation_state::is_p2p_flush_needed( irreversible_block, last_flushed_block ) )
+        continue;
+
+      auto irreversible_data = sql::move_irreveresible_blocks( cached_data, irreversible_block );
+      dumper.trigger_data_flush( irreversible_data, irreversible_block );
+      last_flushed_block = irreversible_block;
+    }
+
+    // hived pushes remaining reversible blocks with the livesync dumper, here they are treated as irreversible
+    if ( !cached_data.blocks.empty() )
+      dumper.trigger_data_flush( cached_data, cached_data.blocks.back().block_number );
+  }
+
+  result.seconds = seconds_since( start );
+  result.peak_rss_kb = peak_rss_kb();
+  return result;
+}
+
+mode_result replay_benchmark::restore_indexes()
+{
+  ilog( "Replay benchmark: restoring indexes and constraints" );
+  mode_result result{ "RESTORE_INDEXES" };
+  reset_peak_rss();
+  const auto start = clock::now();
+
+  _indexes_controler.enable_indexes();
+  _indexes_controler.enable_constrains();
+
+  result.seconds = seconds_since( start );
+  result.peak_rss_kb = peak_rss_kb();
+  return result;
+}
+
+mode_result replay_benchmark::run_live()
+{
+  ilog( "Replay benchmark: LIVE sync of ${b} blocks", ("b", _options.blocks_per_mode) );
+  mode_result result{ "LIVE" };
+
+  // livesync dumper subscribes for irreversible and fork events of the chain, they are never emitted by
+  // the not opened database, hive.set_irreversible is called below in the same way as the dumper does it
+  hive::chain::database chain_db;
+  sql::sql_serializer_plugin plugin;
+  const int32_t first_live_block = _generator.next_block();
+  int32_t irreversible_block = 0;
+  auto set_irreversible = [&irreversible_block]( const sql::data_processor::data_chunk_ptr&, transaction_controllers::transaction& tx ) -> sql::data_processor::data_processing_status {
+    tx.exec( "SELECT hive.set_irreversible(" + std::to_string( irreversible_block ) + ")" );
+    return sql::data_processor::data_processing_status();
+  };
+
+  reset_peak_rss();
+  const auto start = clock::now();
+  {
+    sql::livesync_data_dumper dumper( _options.db_url, plugin, chain_db, _options.operations_threads, _options.transactions_threads, _options.account_operations_threads );
+    sql::queries_commit_data_processor set_irreversible_processor( _options.db_url, "hive.set_irreversible caller", set_irreversible, nullptr );
+
+    for ( uint32_t i = 0; i < _options.blocks_per_mode; ++i )
+    {
+      sql::cached_data_t cached_data( 1 );
+      const auto block_num = append_block( cached_data, result );
+      dumper.trigger_data_flush( cached_data, block_num );
+
+      // only blocks pushed in LIVE sync are in reversible tables
+      if ( block_num - static_cast< int32_t >( _options.reversible_blocks ) < first_live_block )
+        continue;
+
+      constexpr auto NUMBER_WITHOUT_MEANING = 0;
+      irreversible_block = block_num - static_cast< int32_t >( _options.reversible_blocks );
+      set_irreversible_processor.trigger( nullptr, NUMBER_WITHOUT_MEANING );
+      set_irreversible_processor.complete_data_processing();
+    }
+
+    set_irreversible_processor.join();
+  }
+
+  result.seconds = seconds_since( start );
+  result.peak_rss_kb = peak_rss_kb();
+  return result;
+}
+
+int32_t replay_benchmark::append_block( sql::cached_data_t& cached_data, mode_result& result )
+{
+  const auto start = clock::now();
+
+  block_generator::corpus block;
+  _generator.generate( 1, block );
+
+  result.rows += append_rows( cached_data.blocks, block.blocks );
+  result.rows += append_rows( cached_data.transactions, block.transactions );
+  result.rows += append_rows( cached_data.transactions_multisig, block.transactions_multisig );
+  result.rows += append_rows( cached_data.operations, block.operations );
+  result.rows += append_rows( cached_data.accounts, block.accounts );
+  result.rows += append_rows( cached_data.account_operations, block.account_operations );
+  result.rows += append_rows( cached_data.applied_hardforks, block.applied_hardforks );
+  ++result.blocks;
+
+  result.generation_seconds += seconds_since( start );
+  return cached_data.blocks.back().block_number;
+}
+
+} // namespace benchmarks
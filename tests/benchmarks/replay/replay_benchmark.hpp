@@ -0,0 +1,70 @@
+#pragma once
+
+#include <corpus.hpp>
+
+#include <hive/plugins/sql_serializer/cached_data.h>
+#include <hive/plugins/sql_serializer/indexes_controler.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct replay_options
+{
+  std::string db_url;
+  block_generator::generator_profile profile;
+  uint32_t    blocks_per_mode = 0;
+  uint32_t    seed = 0;
+  uint32_t    transactions_threads = 0;
+  uint32_t    operations_threads = 0;
+  uint32_t    account_operations_threads = 0;
+  uint32_t    index_threshold = 0;
+  /// distance between head and last irreversible block in P2P and LIVE modes
+  uint32_t    reversible_blocks = 0;
+};
+
+struct mode_result
+{
+  std::string mode;
+  uint32_t    blocks = 0;
+  uint64_t    rows = 0;
+  double      seconds = 0.0;
+  /// part of seconds spent in generating blocks, it plays the role of hived applying blocks
+  double      generation_seconds = 0.0;
+  uint64_t    peak_rss_kb = 0;
+};
+
+/**
+ * Replays a stream of synthetic blocks through the sql_serializer dumpers in the order in which hived
+ * syncs: REINDEX, P2P, restoring indexes when LIVE sync starts, and LIVE. Flushes are decided by the flush policies
+ * of indexation_state, but without hived: blocks come from the corpus_generator and irreversible block follows
+ * the head with a fixed distance. The database must be a fresh one with hive_fork_manager installed.
+ */
+class replay_benchmark
+{
+public:
+  explicit replay_benchmark( replay_options options );
+
+  std::vector< mode_result > run();
+
+private:
+  void prepare_database();
+  mode_result run_reindex();
+  mode_result run_p2p();
+  mode_result restore_indexes();
+  mode_result run_live();
+
+  /// generates the next block into cached_data and returns its number
+  int32_t append_block( hive::plugins::sql_serializer::cached_data_t& cached_data, mode_result& result );
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  const replay_options                             _options;
+  block_generator::corpus_generator                _generator;
+  hive::plugins::sql_serializer::indexes_controler _indexes_controler;
+};
+
+} // namespace benchmarks
@@ -0,0 +1,72 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    -- the only reversible block
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.app_create_context( 'context' );
+    CREATE TABLE table1( id INT) INHERITS( hive.context );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __blocks hive.blocks_range;
+    __start TIMESTAMPTZ;
+BEGIN
+    -- events_id is moved to the NEW_BLOCK event of block 2 while irreversible block 1 is returned
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 1 AND __blocks.last_block = 1, 'Wrong irreversible block';
+    ASSERT ( SELECT events_id FROM hive.contexts WHERE name='context' ) = 2, 'Events id is not moved to the NEW_BLOCK event';
+
+    -- the reversible block has to be returned without waiting for a next event
+    __start := CLOCK_TIMESTAMP();
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 2 AND __blocks.last_block = 2, 'The first reversible block was not returned';
+    ASSERT CLOCK_TIMESTAMP() - __start < '1 s'::INTERVAL, 'Waited for a next event before the first reversible block';
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT current_block_num FROM hive.contexts WHERE name='context' ) = 2, 'Wrong current block';
+END
+$BODY$
+;
@@ -0,0 +1,120 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD30', '\xCAFE30', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 4, '\xBADD40', '\xCAFE40', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 5, '\xBADD50', '\xCAFE50', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.app_create_context( 'context' );
+    CREATE SCHEMA A;
+    CREATE TABLE A.table1(id  INTEGER ) INHERITS( hive.context );
+
+    PERFORM hive.app_next_block( 'context' ); -- (1,1) MASSIVE_SYNC
+    INSERT INTO A.table1(id) VALUES( 1 );
+    PERFORM hive.app_next_blocks( 'context', 10 ); -- (2,5)
+    INSERT INTO A.table1(id) VALUES( 2 ), ( 3 ), ( 4 ), ( 5 );
+
+    PERFORM hive.back_from_fork( 3 );
+    PERFORM hive.push_block(
+         ( 4, '\xBADD40', '\xCAFE40', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __blocks hive.blocks_range;
+BEGIN
+    -- the fork is inside the range (2,5), all its changes are reverted and blocks 2-3 are returned again
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 2 AND __blocks.last_block = 3, 'Blocks of the reverted range are not returned';
+    ASSERT ( SELECT COUNT(*) FROM A.table1 ) = 1, 'Changes of the reverted range were not reverted';
+    INSERT INTO A.table1(id) VALUES( 2 ), ( 3 );
+
+    SELECT * FROM hive.app_next_blocks( 'context', 10 ) INTO __blocks;
+    ASSERT __blocks.first_block = 4 AND __blocks.last_block = 4, 'Wrong block after the fork';
+    INSERT INTO A.table1(id) VALUES( 40 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT current_block_num FROM hive.contexts WHERE name='context' ) = 4, 'Wrong current block num';
+    ASSERT ( SELECT fork_id FROM hive.contexts WHERE name='context' ) = 2, 'Wrong fork id';
+    ASSERT ( SELECT bulk_ranges FROM hive.contexts WHERE name='context' ) = ARRAY[ int4range( 2, 3, '[]' ) ], 'Wrong bulk ranges';
+
+    ASSERT ( SELECT ARRAY_AGG( id ORDER BY id ) FROM A.table1 ) = ARRAY[ 1, 2, 3, 40 ], 'Wrong rows in app table';
+END
+$BODY$
+;
@@ -0,0 +1,116 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD30', '\xCAFE30', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 4, '\xBADD40', '\xCAFE40', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 5, '\xBADD50', '\xCAFE50', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 6, '\xBADD60', '\xCAFE60', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.app_create_context( 'context' );
+    CREATE SCHEMA A;
+    CREATE TABLE A.table1(id  INTEGER ) INHERITS( hive.context );
+
+    PERFORM hive.app_next_block( 'context' ); -- (1,1) MASSIVE_SYNC
+    INSERT INTO A.table1(id) VALUES( 1 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __blocks hive.blocks_range;
+BEGIN
+    SELECT * FROM hive.app_next_blocks( 'context', 3 ) INTO __blocks;
+    ASSERT __blocks.first_block = 2 AND __blocks.last_block = 4, 'Wrong first range';
+    INSERT INTO A.table1(id) VALUES( 2 ), ( 3 ), ( 4 );
+
+    SELECT * FROM hive.app_next_blocks( 'context', 100 ) INTO __blocks;
+    ASSERT __blocks.first_block = 5 AND __blocks.last_block = 6, 'Wrong second range';
+    INSERT INTO A.table1(id) VALUES( 5 ), ( 6 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT current_block_num FROM hive.contexts WHERE name='context' ) = 6, 'Wrong current block num';
+    ASSERT ( SELECT events_id FROM hive.contexts WHERE name='context' ) = ( SELECT MAX( id ) FROM hive.events_queue ), 'Not all events consumed';
+    ASSERT ( SELECT bulk_ranges FROM hive.contexts WHERE name='context' ) = ARRAY[ int4range( 2, 4, '[]' ), int4range( 5, 6, '[]' ) ], 'Wrong bulk ranges';
+
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_a_table1 WHERE hive_block_num = 4 ) = 3, 'Changes of the first range are not saved with its last block';
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_a_table1 WHERE hive_block_num = 6 ) = 2, 'Changes of the second range are not saved with its last block';
+END
+$BODY$
+;
@@ -0,0 +1,95 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.operation_types
+    VALUES
+          ( 0, 'OP 0', FALSE )
+        , ( 1, 'OP 1', FALSE )
+        , ( 2, 'OP 2', FALSE )
+        , ( 3, 'OP 3', TRUE )
+    ;
+
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.app_create_context( 'context' );
+    CREATE TABLE table1( id INT) INHERITS( hive.context );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __blocks hive.blocks_range;
+    __start TIMESTAMPTZ;
+BEGIN
+    ASSERT hive.app_has_next_event( 'context' ), 'No irreversible block to process';
+    ASSERT hive.wait_for_next_event( 'context', '10 s'::INTERVAL ), 'Waited for an already added block';
+
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 1 AND __blocks.last_block = 1, 'Wrong first block';
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 2 AND __blocks.last_block = 2, 'Wrong second block';
+
+    ASSERT hive.app_has_next_event( 'context' ) = FALSE, 'All events are processed';
+
+    __start := CLOCK_TIMESTAMP();
+    ASSERT hive.wait_for_next_event( 'context', '200 ms'::INTERVAL ) = FALSE, 'No event should come';
+    ASSERT CLOCK_TIMESTAMP() - __start >= '200 ms'::INTERVAL, 'Did not wait until timeout';
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD30', '\xCAFE30', '2016-06-22 19:10:28-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    ASSERT hive.wait_for_next_event( 'context' ), 'New block is not found';
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT current_block_num FROM hive.contexts WHERE name='context' ) = 2, 'Waiting changed the context';
+    ASSERT ( SELECT events_id FROM hive.contexts WHERE name='context' ) = 2, 'Waiting changed events of the context';
+END
+$BODY$
+;
@@ -0,0 +1,84 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD30', '\xCAFE30', '2016-06-22 19:10:28-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    -- no registered tables, the context processes only irreversible blocks
+    PERFORM hive.app_create_context( 'context' );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __blocks hive.blocks_range;
+    __start TIMESTAMPTZ;
+BEGIN
+    SELECT * FROM hive.app_next_block( 'context' ) INTO __blocks;
+    ASSERT __blocks.first_block = 1 AND __blocks.last_block = 1, 'Wrong irreversible block';
+
+    -- the context is at the irreversible head, events of reversible blocks 2 and 3 are not for it
+    ASSERT hive.app_has_next_event( 'context' ) = FALSE, 'Reversible blocks are pending for a non-forking context';
+
+    __start := CLOCK_TIMESTAMP();
+    ASSERT hive.wait_for_next_event( 'context', '1 s'::INTERVAL ) = FALSE, 'Reversible blocks woke up a non-forking context';
+    ASSERT CLOCK_TIMESTAMP() - __start >= '1 s'::INTERVAL, 'Did not wait until timeout';
+
+    PERFORM hive.set_irreversible( 2 );
+
+    ASSERT hive.wait_for_next_event( 'context' ), 'New irreversible block is not found';
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT current_block_num FROM hive.contexts WHERE name='context' ) = 1, 'Waiting changed the context';
+END
+$BODY$
+;
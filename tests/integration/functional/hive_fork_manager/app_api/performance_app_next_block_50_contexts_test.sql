@@ -0,0 +1,100 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+
+    FOR __block IN 2..101 LOOP
+        PERFORM hive.push_block(
+             ( __block, decode( lpad( to_hex( __block ), 8, '0' ), 'hex' ), decode( lpad( to_hex( __block - 1 ), 8, '0' ), 'hex' ), '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+            , NULL
+            , NULL
+            , NULL
+            , NULL
+            , NULL
+            , NULL
+        );
+    END LOOP;
+
+    -- 50 forking applications, like many apps served by one HAF instance, twice: for the queue searched as before and for the queue state
+    FOR __context IN 1..50 LOOP
+        PERFORM hive.app_create_context( 'searching_' || __context );
+        EXECUTE format( 'CREATE TABLE searching_table_%s( id INTEGER ) INHERITS( hive.searching_%s )', __context, __context );
+        PERFORM hive.app_create_context( 'context_' || __context );
+        EXECUTE format( 'CREATE TABLE table_%s( id INTEGER ) INHERITS( hive.context_%s )', __context, __context );
+    END LOOP;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  StartTime timestamptz;
+  EndTime timestamptz;
+  DeltaSearching double precision;
+  Delta double precision;
+  __blocks hive.blocks_range;
+BEGIN
+    -- without valid ids in hive.events_queue_state hive.app_next_block searches the queue for each context, as it did before the state was added
+    UPDATE hive.events_queue_state
+    SET irreversible_block = NULL, last_fork_event_id = 9223372036854775807, last_massive_sync_event_id = 9223372036854775807;
+
+    StartTime := clock_timestamp();
+    -- every context processes each block when it comes, as live apps do
+    FOR __block IN 1..101 LOOP
+        FOR __context IN 1..50 LOOP
+            SELECT * FROM hive.app_next_block( 'searching_' || __context ) INTO __blocks;
+            ASSERT __blocks.first_block = __block AND __blocks.last_block = __block, 'Wrong block ' || __block || ' for searching context ' || __context;
+        END LOOP;
+    END LOOP;
+    EndTime := clock_timestamp();
+    DeltaSearching := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of hive.app_next_block searching the queue for 50 contexts and 101 blocks in millisecs=%', DeltaSearching;
+
+    PERFORM hive.refresh_events_queue_state( ( SELECT consistent_block FROM hive.irreversible_data ) );
+
+    StartTime := clock_timestamp();
+    FOR __block IN 1..101 LOOP
+        FOR __context IN 1..50 LOOP
+            SELECT * FROM hive.app_next_block( 'context_' || __context ) INTO __blocks;
+            ASSERT __blocks.first_block = __block AND __blocks.last_block = __block, 'Wrong block ' || __block || ' for context ' || __context;
+        END LOOP;
+    END LOOP;
+    EndTime := clock_timestamp();
+    Delta := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of hive.app_next_block with the queue state for 50 contexts and 101 blocks in millisecs=%', Delta;
+    RAISE NOTICE 'Speedup of hive.app_next_block=%', DeltaSearching / GREATEST( Delta, 0.001 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM hive.contexts WHERE current_block_num = 101 ) = 100, 'Not all contexts processed all blocks';
+END
+$BODY$
+;
@@ -187,6 +187,18 @@ BEGIN
     EXCEPTION WHEN OTHERS THEN
     END;
 
+    BEGIN
+        UPDATE hive.events_queue_state SET last_fork_event_id = 0;
+        ASSERT FALSE, 'Alice can update hive.events_queue_state';
+    EXCEPTION WHEN OTHERS THEN
+    END;
+
+    BEGIN
+        INSERT INTO hive.bulk_loaded_files VALUES( 'hive.blocks', 1, 10, '/tmp/blocks.copy', 10, now() );
+        ASSERT FALSE, 'Alice can insert to hive.bulk_loaded_files';
+    EXCEPTION WHEN OTHERS THEN
+    END;
+
     BEGIN
         DELETE FROM hive.accounts;
         ASSERT FALSE, 'Alice can delete irreversible accounts';
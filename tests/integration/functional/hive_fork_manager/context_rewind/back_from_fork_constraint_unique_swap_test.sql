@@ -0,0 +1,63 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_create( 'context' );
+    CREATE TABLE table1(
+          id INTEGER NOT NULL
+        , smth TEXT NOT NULL
+        , CONSTRAINT uq_table1 UNIQUE ( smth )
+    ) INHERITS( hive.context );
+
+    PERFORM hive.context_next_block( 'context' );
+    INSERT INTO table1( id, smth ) VALUES( 123, 'blabla1' );
+    INSERT INTO table1( id, smth ) VALUES( 124, 'blabla2' );
+    INSERT INTO table1( id, smth ) VALUES( 125, 'blabla3' );
+
+    TRUNCATE hive.shadow_public_table1; --to do not revert inserts
+
+    -- unique values are swapped between two rows, so a single UPDATE restoring both of them violates uq_table1
+    -- and hive.back_from_fork_one_table falls back to reverting changes row by row
+    PERFORM hive.context_next_block( 'context' );
+    UPDATE table1 SET smth='tmp' WHERE id=123;
+    UPDATE table1 SET smth='blabla1' WHERE id=124;
+    PERFORM hive.context_next_block( 'context' );
+    UPDATE table1 SET smth='blabla2' WHERE id=123;
+    UPDATE table1 SET id=126 WHERE id=125;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_back_from_fork( 'context' , -1 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM table1 ) = 3, 'Wrong number of rows';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=123 AND smth='blabla1' ), 'First row was not restored';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=124 AND smth='blabla2' ), 'Second row was not restored';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=125 AND smth='blabla3' ), 'Third row was not restored';
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_public_table1 ) = 0, 'Shadow table is not empty';
+END
+$BODY$
+;
@@ -0,0 +1,54 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_create( 'context' );
+    CREATE TABLE table1( id INTEGER NOT NULL, smth TEXT NOT NULL ) INHERITS( hive.context );
+    PERFORM hive.context_next_block( 'context' );
+    INSERT INTO table1( id, smth ) VALUES( 1, 'blabla1' );
+
+    TRUNCATE hive.shadow_public_table1; --to do not revert inserts
+
+    -- a row which is inserted, updated and deleted after the fork
+    PERFORM hive.context_next_block( 'context' );
+    INSERT INTO table1( id, smth ) VALUES( 123, 'blabla' );
+    INSERT INTO table1( id, smth ) VALUES( 124, 'blabla' );
+    PERFORM hive.context_next_block( 'context' );
+    UPDATE table1 SET smth='changed' WHERE id IN ( 1, 123, 124 );
+    PERFORM hive.context_next_block( 'context' );
+    DELETE FROM table1 WHERE id=123;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_back_from_fork( 'context' , -1 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM table1 ) = 1, 'Inserted rows were not removed';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=1 AND smth='blabla1' ), 'Updated row was not restored';
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_public_table1 ) = 0, 'Shadow table is not empty';
+END
+$BODY$
+;
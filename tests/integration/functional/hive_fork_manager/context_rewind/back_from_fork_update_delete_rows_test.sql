@@ -0,0 +1,56 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_create( 'context' );
+    CREATE TABLE table1( id INTEGER NOT NULL, smth TEXT NOT NULL ) INHERITS( hive.context );
+    PERFORM hive.context_next_block( 'context' );
+    INSERT INTO table1( id, smth ) VALUES( 1, 'blabla1' ), ( 2, 'blabla2' ), ( 3, 'blabla3' ), ( 4, 'blabla4' );
+
+    TRUNCATE hive.shadow_public_table1; --to do not revert inserts
+
+    -- rows updated and then deleted in next blocks, the earliest change of each row has to be restored
+    PERFORM hive.context_next_block( 'context' );
+    UPDATE table1 SET id = id * 10, smth='changed1' WHERE id IN ( 1, 2, 3 );
+    PERFORM hive.context_next_block( 'context' );
+    UPDATE table1 SET smth='changed2' WHERE id IN ( 10, 20 );
+    PERFORM hive.context_next_block( 'context' );
+    DELETE FROM table1 WHERE id IN ( 10, 30 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_back_from_fork( 'context' , -1 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM table1 ) = 4, 'Wrong number of rows';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=1 AND smth='blabla1' ), 'Updated and deleted row 1 was not restored';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=2 AND smth='blabla2' ), 'Updated row 2 was not restored';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=3 AND smth='blabla3' ), 'Updated and deleted row 3 was not restored';
+    ASSERT EXISTS ( SELECT FROM table1 WHERE id=4 AND smth='blabla4' ), 'Not changed row 4 was changed';
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_public_table1 ) = 0, 'Shadow table is not empty';
+END
+$BODY$
+;
@@ -40,21 +40,21 @@ BEGIN
     ASSERT EXISTS ( SELECT FROM hive.registered_tables WHERE origin_table_schema='public' AND origin_table_name='table1' AND shadow_table_name='shadow_public_table1' );
 
     -- triggers
-    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_insert_trigger_public_table1' AND function_name='hive.hive_on_table_trigger_insert_public_table1' );
+    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_insert_trigger_public_table1' AND function_name='hive.on_registered_table_change' );
     ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_insert_trigger_public_table1');
-    ASSERT EXISTS ( SELECT * FROM pg_proc WHERE proname = 'hive_on_table_trigger_insert_public_table1');
+    ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_insert_trigger_public_table1' AND tgfoid = 'hive.on_registered_table_change'::regproc );
 
-    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_delete_trigger_public_table1' AND function_name='hive.hive_on_table_trigger_delete_public_table1'  );
+    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_delete_trigger_public_table1' AND function_name='hive.on_registered_table_change'  );
     ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_delete_trigger_public_table1' );
-    ASSERT EXISTS ( SELECT * FROM pg_proc WHERE proname = 'hive_on_table_trigger_delete_public_table1');
+    ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_delete_trigger_public_table1' AND tgfoid = 'hive.on_registered_table_change'::regproc );
 
-    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_update_trigger_public_table1' AND function_name='hive.hive_on_table_trigger_update_public_table1' );
+    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_update_trigger_public_table1' AND function_name='hive.on_registered_table_change' );
     ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_update_trigger_public_table1' );
-    ASSERT EXISTS ( SELECT * FROM pg_proc WHERE proname = 'hive_on_table_trigger_update_public_table1');
+    ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_update_trigger_public_table1' AND tgfoid = 'hive.on_registered_table_change'::regproc );
 
-    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_truncate_trigger_public_table1' AND function_name='hive.hive_on_table_trigger_truncate_public_table1' );
+    ASSERT EXISTS ( SELECT FROM hive.triggers WHERE trigger_name='hive.hive_truncate_trigger_public_table1' AND function_name='hive.on_registered_table_change' );
     ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_truncate_trigger_public_table1' );
-    ASSERT EXISTS ( SELECT * FROM pg_proc WHERE proname = 'hive_on_table_trigger_truncate_public_table1');
+    ASSERT EXISTS ( SELECT FROM pg_trigger WHERE tgname='hive.hive_truncate_trigger_public_table1' AND tgfoid = 'hive.on_registered_table_change'::regproc );
 END
 $BODY$
 ;
@@ -0,0 +1,59 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_create( 'context' );
+    CREATE TABLE table1( id INTEGER NOT NULL, smth TEXT NOT NULL ) INHERITS( hive.context );
+    PERFORM hive.context_next_block( 'context' );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    -- state of the context is cached by triggers in a transaction, each change of the context has to be noticed
+    INSERT INTO table1( id, smth ) VALUES( 1, 'blabla' );
+    PERFORM hive.context_next_block( 'context' );
+    INSERT INTO table1( id, smth ) VALUES( 2, 'blabla' );
+
+    BEGIN
+        PERFORM hive.context_next_block( 'context' );
+        INSERT INTO table1( id, smth ) VALUES( 3, 'blabla' );
+        RAISE EXCEPTION 'rollback';
+    EXCEPTION WHEN raise_exception THEN
+    END;
+
+    INSERT INTO table1( id, smth ) VALUES( 4, 'blabla' );
+    UPDATE hive.contexts SET back_from_fork = TRUE WHERE name = 'context';
+    INSERT INTO table1( id, smth ) VALUES( 5, 'blabla' );
+    UPDATE hive.contexts SET back_from_fork = FALSE WHERE name = 'context';
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 1 AND hive_block_num = 1 ), 'Wrong block num of the first row';
+    ASSERT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 2 AND hive_block_num = 2 ), 'Next block was not noticed';
+    ASSERT NOT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 3 ), 'Rolled back row in the shadow table';
+    ASSERT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 4 AND hive_block_num = 2 ), 'Rolled back next block was not noticed';
+    ASSERT NOT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 5 ), 'Row inserted during back from fork in the shadow table';
+END
+$BODY$
+;
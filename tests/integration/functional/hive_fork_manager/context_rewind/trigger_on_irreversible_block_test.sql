@@ -0,0 +1,50 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_create( 'context' );
+    CREATE TABLE table1( id INTEGER NOT NULL, smth TEXT NOT NULL ) INHERITS( hive.context );
+    PERFORM hive.context_set_irreversible_block( 'context', 2 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM hive.context_next_block( 'context' ); -- 1 irreversible
+    INSERT INTO table1( id, smth ) VALUES( 1, 'blabla' );
+    PERFORM hive.context_next_block( 'context' ); -- 2 irreversible
+    UPDATE table1 SET smth = 'changed' WHERE id = 1;
+    INSERT INTO table1( id, smth ) VALUES( 2, 'blabla' );
+    PERFORM hive.context_next_block( 'context' ); -- 3 reversible
+    INSERT INTO table1( id, smth ) VALUES( 3, 'blabla' );
+    DELETE FROM table1 WHERE id = 2;
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM table1 ) = 2, 'Wrong number of rows in the table';
+    ASSERT ( SELECT COUNT(*) FROM hive.shadow_public_table1 ) = 2, 'Changes of irreversible blocks were captured';
+    ASSERT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 3 AND hive_block_num = 3 AND hive_operation_type = 'INSERT' ), 'No insert of block 3';
+    ASSERT EXISTS ( SELECT FROM hive.shadow_public_table1 hs WHERE hs.id = 2 AND hive_block_num = 3 AND hive_operation_type = 'DELETE' ), 'No delete of block 3';
+END
+$BODY$
+;
@@ -0,0 +1,102 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    PERFORM hive.end_massive_sync( 1 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+    __state hive.events_queue_state%ROWTYPE;
+BEGIN
+    SELECT * INTO __state FROM hive.events_queue_state;
+    ASSERT __state.irreversible_block = 1, 'Wrong irreversible block after massive sync';
+    ASSERT __state.irreversible_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'MASSIVE_SYNC' ), 'Wrong irreversible event after massive sync';
+    ASSERT __state.first_reversible_event_id IS NULL, 'Reversible event before a block is pushed';
+    ASSERT __state.last_massive_sync_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'MASSIVE_SYNC' ), 'Wrong massive sync event';
+    ASSERT __state.last_fork_event_id = 0, 'Fork event before a fork';
+
+    PERFORM hive.push_block(
+         ( 2, '\xBADD20', '\xCAFE20', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD30', '\xCAFE30', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    SELECT * INTO __state FROM hive.events_queue_state;
+    ASSERT __state.first_reversible_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'NEW_BLOCK' AND block_num = 2 ), 'Wrong first reversible event after push_block';
+
+    PERFORM hive.back_from_fork( 2 );
+
+    PERFORM hive.push_block(
+         ( 3, '\xBADD31', '\xCAFE31', '2016-06-22 19:10:25-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+        , NULL
+    );
+
+    SELECT * INTO __state FROM hive.events_queue_state;
+    ASSERT __state.last_fork_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'BACK_FROM_FORK' ), 'Wrong fork event after back_from_fork';
+    ASSERT __state.first_reversible_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'NEW_BLOCK' AND block_num = 2 ), 'First reversible event changed after a fork';
+
+    PERFORM hive.set_irreversible( 2 );
+END
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+DECLARE
+    __state hive.events_queue_state%ROWTYPE;
+BEGIN
+    SELECT * INTO __state FROM hive.events_queue_state;
+    ASSERT __state.irreversible_block = 2, 'Wrong irreversible block after set_irreversible';
+    ASSERT __state.irreversible_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'NEW_IRREVERSIBLE' AND block_num = 2 ), 'Wrong irreversible event after set_irreversible';
+    ASSERT __state.first_reversible_event_id = ( SELECT MIN(id) FROM hive.events_queue WHERE event = 'NEW_BLOCK' AND block_num = 3 ), 'Wrong first reversible event after set_irreversible';
+    ASSERT __state.last_fork_event_id = ( SELECT id FROM hive.events_queue WHERE event = 'BACK_FROM_FORK' ), 'Wrong fork event after set_irreversible';
+    -- the massive sync event was removed with other events older than the irreversible block
+    ASSERT __state.last_massive_sync_event_id = 0, 'Removed massive sync event is still in the state';
+END
+$BODY$
+;
@@ -33,6 +33,7 @@ AS
 $BODY$
 BEGIN
     ASSERT EXISTS ( SELECT FROM information_schema.tables WHERE table_schema='hive' AND table_name = 'events_queue' ), 'No events_queue table';
+    ASSERT ( SELECT COUNT(*) FROM hive.events_queue_state ) = 1, 'No events_queue_state row';
     ASSERT ( SELECT COUNT(*) FROM hive.fork ) = 1, 'No default fork or to much forks by start';
 END
 $BODY$
@@ -0,0 +1,79 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    CREATE TABLE public.ops( id INT, body hive.operation );
+    INSERT INTO public.ops
+    VALUES
+          ( 1, '{"type":"vote_operation","value":{"voter":"andzzz","author":"signalandnoise","permlink":"hello-","weight":-10000}}' )
+        , ( 2, '{"type":"transfer_operation","value":{"from":"faddy3","to":"faddy","amount":{"amount":"40000","precision":3,"nai":"@@000000021"},"memo":"this is a test"}}' )
+        , ( 3, '{"type":"account_update_operation","value":{"account":"theoretical","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}' )
+        , ( 4, '{"type":"pow2_operation","value":{"work":{"type":"pow2","value":{"input":{"worker_account":"b0y2k31","prev_block":"003ea73c674962ad0e406d6d49736092b43fb385","nonce":"219420911219087363"},"pow_summary":3858814423}},"props":{"account_creation_fee":{"amount":"1","precision":3,"nai":"@@000000021"},"maximum_block_size":131072,"hbd_interest_rate":1000}}}' )
+        , ( 5, '{"type":"limit_order_create_operation","value":{"owner":"adm","orderid":1,"amount_to_sell":{"amount":"1000","precision":3,"nai":"@@000000021"},"min_to_receive":{"amount":"1000","precision":3,"nai":"@@000000013"},"fill_or_kill":false,"expiration":"2016-05-31T21:44:00"}}' )
+        , ( 6, '{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["bob","carol"],"id":"follow","json":"{\"a\":1}"}}' )
+    ;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+BEGIN
+    -- the accessors are immutable, so they can be used in expression indexes
+    CREATE INDEX ops_from_idx ON public.ops( hive.operation_field_text( body, 'from' ) ) WHERE hive.operation_type_id( body ) = 2;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT array_agg( hive.operation_type_id( body ) ORDER BY id ) FROM public.ops ) = '{0,2,10,30,5,18}'::SMALLINT[], 'Wrong types of operations';
+    ASSERT hive.operation_type_id( ''::bytea::hive.operation ) IS NULL, 'Empty operation has a type';
+
+    -- strings are not quoted
+    ASSERT ( SELECT hive.operation_field_text( body, 'voter' ) FROM public.ops WHERE id = 1 ) = 'andzzz', 'Wrong vote_operation voter';
+    ASSERT ( SELECT hive.operation_field_text( body, 'weight' ) FROM public.ops WHERE id = 1 ) = '-10000', 'Wrong vote_operation weight';
+    ASSERT ( SELECT hive.operation_field_text( body, 'from' ) FROM public.ops WHERE id = 2 ) = 'faddy3', 'Wrong transfer_operation from';
+    ASSERT ( SELECT hive.operation_field_text( body, 'memo' ) FROM public.ops WHERE id = 2 ) = 'this is a test', 'Wrong transfer_operation memo';
+    ASSERT ( SELECT hive.operation_field_text( body, 'expiration' ) FROM public.ops WHERE id = 5 ) = '2016-05-31T21:44:00', 'Wrong limit_order_create_operation expiration';
+    ASSERT ( SELECT hive.operation_field_text( body, 'fill_or_kill' ) FROM public.ops WHERE id = 5 ) = 'false', 'Wrong limit_order_create_operation fill_or_kill';
+
+    -- other values are JSON, the same as members of operation::jsonb
+    ASSERT ( SELECT hive.operation_field_text( body, 'amount' )::jsonb = body::jsonb #> '{value,amount}' FROM public.ops WHERE id = 2 ), 'Wrong transfer_operation amount';
+    ASSERT ( SELECT hive.operation_field_text( body, 'posting' )::jsonb = body::jsonb #> '{value,posting}' FROM public.ops WHERE id = 3 ), 'Wrong account_update_operation posting';
+    ASSERT ( SELECT hive.operation_field_text( body, 'work' )::jsonb = body::jsonb #> '{value,work}' FROM public.ops WHERE id = 4 ), 'Wrong pow2_operation work';
+    ASSERT ( SELECT hive.operation_field_text( body, 'props' )::jsonb = body::jsonb #> '{value,props}' FROM public.ops WHERE id = 4 ), 'Wrong pow2_operation props';
+
+    -- exact text of not string members is compact JSON
+    ASSERT ( SELECT hive.operation_field_text( body, 'orderid' ) FROM public.ops WHERE id = 5 ) = '1', 'Wrong text of limit_order_create_operation orderid';
+    ASSERT ( SELECT hive.operation_field_text( body, 'amount' ) FROM public.ops WHERE id = 2 ) = '{"amount":"40000","precision":3,"nai":"@@000000021"}', 'Wrong text of transfer_operation amount';
+    ASSERT ( SELECT hive.operation_field_text( body, 'min_to_receive' ) FROM public.ops WHERE id = 5 ) = '{"amount":"1000","precision":3,"nai":"@@000000013"}', 'Wrong text of limit_order_create_operation min_to_receive';
+    ASSERT ( SELECT hive.operation_field_text( body, 'required_posting_auths' ) FROM public.ops WHERE id = 6 ) = '["bob","carol"]', 'Wrong text of custom_json_operation required_posting_auths';
+    ASSERT ( SELECT hive.operation_field_text( body, 'required_auths' ) FROM public.ops WHERE id = 6 ) = '[]', 'Wrong text of custom_json_operation required_auths';
+    ASSERT ( SELECT hive.operation_field_text( body, 'json' ) FROM public.ops WHERE id = 6 ) = '{"a":1}', 'Wrong text of custom_json_operation json';
+
+    -- members after empty optionals are found, empty optionals and unknown members are NULL
+    ASSERT ( SELECT hive.operation_field_text( body, 'memo_key' ) FROM public.ops WHERE id = 3 ) = 'STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo', 'Wrong account_update_operation memo_key';
+    ASSERT ( SELECT hive.operation_field_text( body, 'owner' ) FROM public.ops WHERE id = 3 ) IS NULL, 'Empty owner of account_update_operation is not NULL';
+    ASSERT ( SELECT hive.operation_field_text( body, 'from' ) FROM public.ops WHERE id = 1 ) IS NULL, 'vote_operation has no from';
+
+    -- keyauths operations are recognized by the type of operation
+    ASSERT ( SELECT array_agg( hive.is_keyauths_operation( body ) ORDER BY id ) FROM public.ops ) = '{false,false,true,false,false,false}'::BOOLEAN[], 'Wrong keyauths operations';
+END
+$BODY$
+;
@@ -0,0 +1,60 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    -- more different operations than the cache holds, each of them used by several rows
+    CREATE TABLE public.ops( id INT, account TEXT, body hive.operation );
+    INSERT INTO public.ops
+    SELECT gs.id, 'account' || ( gs.id % 20 ), format( '{"type":"account_update_operation","value":{"account":"account%s","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}', gs.id % 20 )::hive.operation
+    FROM generate_series( 1, 200 ) gs( id );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+BEGIN
+    --Nothing to do
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    -- operations taken from the cache are the ones of the rows
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.ops o WHERE ARRAY( SELECT hive.get_impacted_accounts( o.body ) ) != ARRAY[ o.account ]
+    ), 'Impacted accounts of other operation';
+
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.ops o WHERE o.body::jsonb #>> '{value,account}' != o.account OR hive.get_legacy_style_operation( o.body )::jsonb #>> '{1,account}' != o.account
+    ), 'Converted other operation';
+
+    -- the function expanded for each column gives the same rows as called once
+    ASSERT ( SELECT COUNT(*) FROM ( SELECT o.id, ( hive.get_keyauths( o.body ) ).* FROM public.ops o ) expanded ) >= 200, 'Too few keyauths';
+    ASSERT NOT EXISTS (
+        SELECT o.id, ( hive.get_keyauths( o.body ) ).* FROM public.ops o
+        EXCEPT
+        SELECT o.id, ka.* FROM public.ops o, hive.get_keyauths( o.body ) ka
+    ), 'Expanded get_keyauths gives other rows';
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.ops o, hive.get_keyauths( o.body ) ka WHERE ka.account_name != o.account
+    ), 'Keyauths of other operation';
+END
+$BODY$
+;
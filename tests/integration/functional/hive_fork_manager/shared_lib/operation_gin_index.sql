@@ -0,0 +1,80 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    CREATE TABLE public.ops( id INT, body hive.operation );
+    INSERT INTO public.ops
+    VALUES
+          ( 1, '{"type":"vote_operation","value":{"voter":"andzzz","author":"signalandnoise","permlink":"hello-","weight":-10000}}' )
+        , ( 2, '{"type":"transfer_operation","value":{"from":"faddy3","to":"faddy","amount":{"amount":"40000","precision":3,"nai":"@@000000021"},"memo":"this is a test"}}' )
+        , ( 3, '{"type":"account_update_operation","value":{"account":"theoretical","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}' )
+        , ( 4, '{"type":"transfer_operation","value":{"from":"faddy","to":"andzzz","amount":{"amount":"1000","precision":3,"nai":"@@000000013"},"memo":""}}' )
+        , ( 5, '{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["dantheman"],"id":"follow","json":"[\"follow\",{\"follower\":\"dantheman\",\"following\":\"red\",\"what\":[\"blog\"]}]"}}' )
+    ;
+    -- other operations, so the index is worth using
+    INSERT INTO public.ops
+    SELECT 100 + gs.id, '{"type":"vote_operation","value":{"voter":"dantheman","author":"red","permlink":"888","weight":100}}'
+    FROM generate_series( 1, 1000 ) gs( id );
+
+    CREATE TABLE public.plans( query TEXT, plan JSON );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+DECLARE
+    __query TEXT;
+    __plan JSON;
+BEGIN
+    CREATE INDEX ops_body_gin_idx ON public.ops USING gin( body );
+    ANALYZE public.ops;
+
+    PERFORM set_config( 'enable_seqscan', 'off', true );
+    FOREACH __query IN ARRAY ARRAY[ 'SELECT id FROM public.ops WHERE body @@ ''account:faddy''', 'SELECT id FROM public.ops WHERE body @@ ''type:2''' ]
+    LOOP
+        EXECUTE 'EXPLAIN ( FORMAT JSON ) ' || __query INTO __plan;
+        INSERT INTO public.plans VALUES( __query, __plan );
+    END LOOP;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.plans p WHERE NOT jsonb_path_exists( p.plan::jsonb, '$.** ? (@."Index Name" == "ops_body_gin_idx")' )
+    ), 'The GIN index is not used';
+
+    -- impacted accounts
+    ASSERT ( SELECT array_agg( id ORDER BY id ) FROM public.ops WHERE body @@ 'account:faddy' ) = '{2,4}'::INT[], 'Wrong operations of faddy';
+    ASSERT ( SELECT array_agg( id ORDER BY id ) FROM public.ops WHERE body @@ 'account:andzzz' ) = '{1,4}'::INT[], 'Wrong operations of andzzz';
+    ASSERT ( SELECT array_agg( id ORDER BY id ) FROM public.ops WHERE body @@ 'account:theoretical' ) = '{3}'::INT[], 'Wrong operations of theoretical';
+    ASSERT ( SELECT COUNT(*) FROM public.ops WHERE body @@ 'account:dantheman' ) = 1001, 'Wrong operations of dantheman';
+    ASSERT NOT EXISTS ( SELECT NULL FROM public.ops WHERE body @@ 'account:nobody' ), 'Operations of not impacted account';
+
+    -- types of operations
+    ASSERT ( SELECT array_agg( id ORDER BY id ) FROM public.ops WHERE body @@ 'type:2' ) = '{2,4}'::INT[], 'Wrong transfer operations';
+    ASSERT ( SELECT array_agg( id ORDER BY id ) FROM public.ops WHERE body @@ 'account:faddy' AND body @@ 'type:2' AND id > 3 ) = '{4}'::INT[], 'Wrong transfers of faddy';
+
+    -- the index gives the same results as the operator itself and hive.get_impacted_accounts
+    ASSERT ( SELECT COUNT(*) FROM public.ops WHERE hive._operation_matches( body, 'account:red' ) )
+         = ( SELECT COUNT(*) FROM public.ops WHERE 'red' IN ( SELECT hive.get_impacted_accounts( body ) ) ), 'Operator gives other results than get_impacted_accounts';
+END
+$BODY$
+;
@@ -0,0 +1,68 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    --Nothing to do
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS ASSERT_THIS_TEST;
+CREATE FUNCTION ASSERT_THIS_TEST(op TEXT)
+    RETURNS void
+    LANGUAGE 'plpgsql'
+AS
+$BODY$
+BEGIN
+  -- Texts below were written by fc::json::to_string, operation::text has to give them back character by character.
+  ASSERT ( SELECT op::hive.operation::text = op ), FORMAT( 'operation::text conversion changed %s into %s', op, op::hive.operation::text );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+    VOLATILE
+AS
+$BODY$
+BEGIN
+  PERFORM ASSERT_THIS_TEST('{"type":"vote_operation","value":{"voter":"andzzz","author":"signalandnoise","permlink":"hello-","weight":-10000}}');
+  PERFORM ASSERT_THIS_TEST('{"type":"transfer_operation","value":{"from":"faddy3","to":"faddy","amount":{"amount":"40000","precision":3,"nai":"@@000000021"},"memo":"this is a test"}}');
+  -- characters escaped in strings
+  PERFORM ASSERT_THIS_TEST('{"type":"transfer_operation","value":{"from":"faddy3","to":"faddy","amount":{"amount":"40000","precision":3,"nai":"@@000000021"},"memo":"say \"hi\" \\ to\n\tall"}}');
+  -- integers which do not fit in 32 bits are strings
+  PERFORM ASSERT_THIS_TEST('{"type":"pow2_operation","value":{"work":{"type":"pow2","value":{"input":{"worker_account":"b0y2k31","prev_block":"003ea73c674962ad0e406d6d49736092b43fb385","nonce":"219420911219087363"},"pow_summary":3858814423}},"props":{"account_creation_fee":{"amount":"1","precision":3,"nai":"@@000000021"},"maximum_block_size":131072,"hbd_interest_rate":1000}}}');
+  PERFORM ASSERT_THIS_TEST('{"type":"limit_order_cancel_operation","value":{"owner":"complexring","orderid":4294967295}}');
+  -- empty optional authorities are not written
+  PERFORM ASSERT_THIS_TEST('{"type":"account_update_operation","value":{"account":"theoretical","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}');
+  PERFORM ASSERT_THIS_TEST('{"type":"witness_set_properties_operation","value":{"owner":"holger80","props":[["account_creation_fee","b80b00000000000003535445454d0000"],["key","0295a26f54381a6dba8eb5dc7536e57db267685f9386c714ead9be39a905364a88"]],"extensions":[]}}');
+  PERFORM ASSERT_THIS_TEST('{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["dantheman"],"id":"follow","json":"[\"follow\",{\"follower\":\"dantheman\",\"following\":\"red\",\"what\":[\"blog\"]}]"}}');
+  PERFORM ASSERT_THIS_TEST('{"type":"limit_order_create_operation","value":{"owner":"adm","orderid":1,"amount_to_sell":{"amount":"1000","precision":3,"nai":"@@000000021"},"min_to_receive":{"amount":"1000","precision":3,"nai":"@@000000013"},"fill_or_kill":false,"expiration":"2016-05-31T21:44:00"}}');
+
+  -- the legacy format is written by the same writer
+  ASSERT ( SELECT hive.get_legacy_style_operation('{"type":"transfer_operation","value":{"from":"faddy3","to":"faddy","amount":{"amount":"40000","precision":3,"nai":"@@000000021"},"memo":"this is a test"}}'::hive.operation) )
+    = '["transfer",{"from":"faddy3","to":"faddy","amount":"40.000 HIVE","memo":"this is a test"}]', 'Wrong legacy transfer_operation';
+  ASSERT ( SELECT hive.get_legacy_style_operation('{"type":"limit_order_create_operation","value":{"owner":"adm","orderid":1,"amount_to_sell":{"amount":"1000","precision":3,"nai":"@@000000021"},"min_to_receive":{"amount":"1000","precision":3,"nai":"@@000000013"},"fill_or_kill":false,"expiration":"2016-05-31T21:44:00"}}'::hive.operation) )
+    = '["limit_order_create",{"owner":"adm","orderid":1,"amount_to_sell":"1.000 HIVE","min_to_receive":"1.000 HBD","fill_or_kill":false,"expiration":"2016-05-31T21:44:00"}]', 'Wrong legacy limit_order_create_operation';
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    --Nothing to do
+END;
+$BODY$
+;
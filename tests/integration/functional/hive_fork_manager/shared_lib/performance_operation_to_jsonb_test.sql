@@ -0,0 +1,90 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.operation_types
+    VALUES
+          ( 0, 'hive::protocol::vote_operation', FALSE )
+        , ( 2, 'hive::protocol::transfer_operation', FALSE )
+        , ( 18, 'hive::protocol::custom_json_operation', FALSE )
+        , ( 14, 'hive::protocol::pow_operation', FALSE )
+    ;
+
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    -- ten thousand operations of types with integers, assets, strings and nested objects
+    INSERT INTO hive.operations( id, block_num, trx_in_block, op_pos, op_type_id, timestamp, body )
+    SELECT ops.id, 1, 0, ops.id, bodies.op_type_id, '2016-06-22 19:10:21-07'::timestamp, bodies.body::hive.operation
+    FROM generate_series( 0, 9999 ) ops( id )
+    JOIN (
+        VALUES
+              ( 0, 0, '{"type":"vote_operation","value":{"voter":"dantheman","author":"red","permlink":"888","weight":-100}}' )
+            , ( 1, 2, '{"type":"transfer_operation","value":{"from":"admin","to":"steemit","amount":{"amount":"833000","precision":3,"nai":"@@000000021"},"memo":"a memo of the transfer"}}' )
+            , ( 2, 18, '{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["dantheman"],"id":"follow","json":"[\"follow\",{\"follower\":\"dantheman\",\"following\":\"red\",\"what\":[\"blog\"]}]"}}' )
+            , ( 3, 14, '{"type":"pow_operation","value":{"worker_account":"sminer10","block_id":"00015d56d6e721ede5aad1babb0fe818203cbeeb","nonce":"42","work":{"worker":"STM6tC4qRjUPKmkqkug5DvSgkeND5DHhnfr3XTgpp4b4nejMEwn9k","input":"c55811a1a9cf6a281acad3aba38223027158186cfd280c41fffe5e2b0d2d6e0b","signature":"1fbce97f375ac548c185905ac8e44a9c8b50b7e618bf4a7559816d8316e3b09ff54da096c2f5eddcca1229cf0b9da9597eac2ae676e424bdb432a7855295cd81aa","work":"000000049711861bce6185671b672696eca64398586a66319eacd875155b77fc"},"props":{"account_creation_fee":{"amount":"100000","precision":3,"nai":"@@000000021"},"maximum_block_size":131072,"hbd_interest_rate":1000}}}' )
+    ) AS bodies( kind, op_type_id, body ) ON bodies.kind = ops.id % 4;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  StartTime timestamptz;
+  EndTime timestamptz;
+  Delta double precision;
+  __count BIGINT;
+BEGIN
+    StartTime := clock_timestamp();
+    SELECT COUNT( ho.body::jsonb ) INTO __count FROM hive.operations ho;
+    EndTime := clock_timestamp();
+    Delta := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of body::jsonb for % operations in millisecs=%', __count, Delta;
+
+    StartTime := clock_timestamp();
+    SELECT COUNT( ho.body::text::jsonb ) INTO __count FROM hive.operations ho;
+    EndTime := clock_timestamp();
+    Delta := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of body::text::jsonb for % operations in millisecs=%', __count, Delta;
+
+    StartTime := clock_timestamp();
+    SELECT COUNT( ho.body::text ) INTO __count FROM hive.operations ho;
+    EndTime := clock_timestamp();
+    Delta := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of body::text for % operations in millisecs=%', __count, Delta;
+
+    StartTime := clock_timestamp();
+    SELECT COUNT( hive.get_legacy_style_operation( ho.body ) ) INTO __count FROM hive.operations ho;
+    EndTime := clock_timestamp();
+    Delta := 1000 * ( extract(epoch from EndTime) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of hive.get_legacy_style_operation for % operations in millisecs=%', __count, Delta;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM hive.operations ho WHERE ho.body::jsonb != ho.body::text::jsonb
+    ), 'operation::jsonb does not match operation::text::jsonb';
+    ASSERT ( SELECT body::jsonb #> '{"value", "amount", "precision"}' FROM hive.operations WHERE id = 1 ) = '3'::jsonb, 'Wrong precision of asset';
+END
+$BODY$
+;
@@ -0,0 +1,120 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.operation_types
+    VALUES
+          ( 0, 'hive::protocol::vote_operation', FALSE )
+        , ( 2, 'hive::protocol::transfer_operation', FALSE )
+        , ( 10, 'hive::protocol::account_update_operation', FALSE )
+        , ( 18, 'hive::protocol::custom_json_operation', FALSE )
+    ;
+
+    INSERT INTO hive.blocks
+    SELECT gs.num, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000
+    FROM generate_series( 1, 1250 ) gs( num )
+    ;
+
+    -- 20 operations in each block, the operations are read in several batches of scan_operations_in_range
+    INSERT INTO hive.operations( id, block_num, trx_in_block, op_pos, op_type_id, timestamp, body )
+    SELECT ops.id, 1 + ops.id / 20, 0, ops.id % 20, bodies.op_type_id, '2016-06-22 19:10:21-07'::timestamp, bodies.body::hive.operation
+    FROM generate_series( 0, 24999 ) ops( id )
+    JOIN (
+        VALUES
+              ( 0, 0, '{"type":"vote_operation","value":{"voter":"dantheman","author":"red","permlink":"888","weight":-100}}' )
+            , ( 1, 2, '{"type":"transfer_operation","value":{"from":"admin","to":"steemit","amount":{"amount":"833000","precision":3,"nai":"@@000000021"},"memo":"a memo of the transfer"}}' )
+            , ( 2, 10, '{"type":"account_update_operation","value":{"account":"theoretical","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}' )
+            , ( 3, 18, '{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["dantheman"],"id":"follow","json":"[\"follow\",{\"follower\":\"dantheman\",\"following\":\"red\",\"what\":[\"blog\"]}]"}}' )
+    ) AS bodies( kind, op_type_id, body ) ON bodies.kind = ops.id % 4;
+
+    -- balances of operations before and after HF01 differ
+    INSERT INTO hive.applied_hardforks VALUES ( 1, 625, 12480 );
+
+    ANALYZE hive.operations;
+
+    CREATE TABLE public.per_row_accounts( operation_id BIGINT, account_name TEXT );
+    CREATE TABLE public.batch_accounts( operation_id BIGINT, account_name TEXT );
+    CREATE TABLE public.per_row_balances( operation_id BIGINT, account_name VARCHAR, amount BIGINT, asset_precision INT, asset_symbol_nai INT );
+    CREATE TABLE public.batch_balances( operation_id BIGINT, account_name VARCHAR, amount BIGINT, asset_precision INT, asset_symbol_nai INT );
+    CREATE TABLE public.per_row_keyauths( operation_id BIGINT, key_auth TEXT, authority_kind hive.authority_type, account_name TEXT );
+    CREATE TABLE public.batch_keyauths( operation_id BIGINT, key_auth TEXT, authority_kind hive.authority_type, account_name TEXT );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS measure;
+CREATE FUNCTION measure( _name TEXT, _query TEXT )
+    RETURNS FLOAT
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  StartTime timestamptz;
+  __duration FLOAT;
+BEGIN
+    StartTime := clock_timestamp();
+    EXECUTE _query;
+    __duration := 1000 * ( extract(epoch from clock_timestamp()) - extract(epoch from StartTime) );
+    RAISE NOTICE 'Duration of % in millisecs=%', _name, __duration;
+    RETURN __duration;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  __per_row FLOAT;
+  __batch FLOAT;
+BEGIN
+    __per_row := measure( 'get_impacted_accounts per operation', 'INSERT INTO public.per_row_accounts SELECT ho.id, hive.get_impacted_accounts( ho.body ) FROM hive.operations ho WHERE ho.block_num BETWEEN 1 AND 1250' );
+    __batch := measure( 'get_impacted_accounts_in_range', 'INSERT INTO public.batch_accounts SELECT * FROM hive.get_impacted_accounts_in_range( 1, 1250 )' );
+    RAISE NOTICE 'Speedup of get_impacted_accounts_in_range=%', round( ( __per_row / GREATEST( __batch, 1 ) )::NUMERIC, 2 );
+
+    __per_row := measure( 'get_impacted_balances per operation', 'INSERT INTO public.per_row_balances SELECT ho.id, ( hive.get_impacted_balances( ho.body, ho.block_num ) ).* FROM hive.operations ho WHERE ho.block_num BETWEEN 1 AND 1250' );
+    __batch := measure( 'get_impacted_balances_in_range', 'INSERT INTO public.batch_balances SELECT * FROM hive.get_impacted_balances_in_range( 1, 1250 )' );
+    RAISE NOTICE 'Speedup of get_impacted_balances_in_range=%', round( ( __per_row / GREATEST( __batch, 1 ) )::NUMERIC, 2 );
+
+    __per_row := measure( 'get_keyauths per operation', 'INSERT INTO public.per_row_keyauths SELECT ho.id, ( hive.get_keyauths( ho.body ) ).* FROM hive.operations ho WHERE hive.is_keyauths_operation( ho.body ) AND ho.block_num BETWEEN 1 AND 1250' );
+    __batch := measure( 'get_keyauths_in_range', 'INSERT INTO public.batch_keyauths SELECT * FROM hive.get_keyauths_in_range( 1, 1250 )' );
+    RAISE NOTICE 'Speedup of get_keyauths_in_range=%', round( ( __per_row / GREATEST( __batch, 1 ) )::NUMERIC, 2 );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM public.batch_accounts ) >= 25000, 'Too few impacted accounts';
+    ASSERT ( SELECT COUNT(*) FROM public.per_row_accounts ) = ( SELECT COUNT(*) FROM public.batch_accounts ), 'Wrong number of impacted accounts';
+    ASSERT NOT EXISTS ( SELECT * FROM public.per_row_accounts EXCEPT ALL SELECT * FROM public.batch_accounts ), 'Wrong impacted accounts';
+
+    ASSERT ( SELECT COUNT(*) FROM public.batch_balances ) >= 12500, 'Too few impacted balances';
+    ASSERT ( SELECT COUNT(*) FROM public.per_row_balances ) = ( SELECT COUNT(*) FROM public.batch_balances ), 'Wrong number of impacted balances';
+    ASSERT NOT EXISTS ( SELECT * FROM public.per_row_balances EXCEPT ALL SELECT * FROM public.batch_balances ), 'Wrong impacted balances';
+
+    ASSERT ( SELECT COUNT(*) FROM public.batch_keyauths ) >= 6250, 'Too few keyauths';
+    ASSERT ( SELECT COUNT(*) FROM public.per_row_keyauths ) = ( SELECT COUNT(*) FROM public.batch_keyauths ), 'Wrong number of keyauths';
+    ASSERT NOT EXISTS ( SELECT * FROM public.per_row_keyauths EXCEPT ALL SELECT * FROM public.batch_keyauths ), 'Wrong keyauths';
+
+    -- a part of the range and another relation of operations
+    ASSERT ( SELECT COUNT( DISTINCT operation_id ) FROM hive.get_impacted_accounts_in_range( 11, 20 ) ) = 200, 'Wrong operations of blocks 11-20';
+    ASSERT ( SELECT COUNT(*) FROM hive.get_impacted_accounts_in_range( 1, 1250, 'hive.operations_reversible' ) ) = 0, 'Operations of an empty relation';
+END
+$BODY$
+;
@@ -0,0 +1,118 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.operation_types
+    VALUES
+          ( 0, 'hive::protocol::vote_operation', FALSE )
+        , ( 2, 'hive::protocol::transfer_operation', FALSE )
+        , ( 10, 'hive::protocol::account_update_operation', FALSE )
+        , ( 18, 'hive::protocol::custom_json_operation', FALSE )
+    ;
+
+    INSERT INTO hive.blocks
+    VALUES ( 1, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000 )
+    ;
+
+    INSERT INTO hive.operations( id, block_num, trx_in_block, op_pos, op_type_id, timestamp, body )
+    SELECT ops.id, 1, 0, ops.id, bodies.op_type_id, '2016-06-22 19:10:21-07'::timestamp, bodies.body::hive.operation
+    FROM generate_series( 0, 9999 ) ops( id )
+    JOIN (
+        VALUES
+              ( 0, 0, '{"type":"vote_operation","value":{"voter":"dantheman","author":"red","permlink":"888","weight":-100}}' )
+            , ( 1, 2, '{"type":"transfer_operation","value":{"from":"admin","to":"steemit","amount":{"amount":"833000","precision":3,"nai":"@@000000021"},"memo":"a memo of the transfer"}}' )
+            , ( 2, 10, '{"type":"account_update_operation","value":{"account":"theoretical","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}' )
+            , ( 3, 18, '{"type":"custom_json_operation","value":{"required_auths":[],"required_posting_auths":["dantheman"],"id":"follow","json":"[\"follow\",{\"follower\":\"dantheman\",\"following\":\"red\",\"what\":[\"blog\"]}]"}}' )
+    ) AS bodies( kind, op_type_id, body ) ON bodies.kind = ops.id % 4;
+
+    ANALYZE hive.operations;
+
+    CREATE TABLE public.parallel_measurements( name TEXT, serial_result BIGINT, parallel_result BIGINT, serial_ms FLOAT, parallel_ms FLOAT, plan JSON );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS measure_parallel_speedup;
+CREATE FUNCTION measure_parallel_speedup( _name TEXT, _query TEXT )
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  StartTime timestamptz;
+  __serial_ms FLOAT;
+  __parallel_ms FLOAT;
+  __serial_result BIGINT;
+  __parallel_result BIGINT;
+  __plan JSON;
+BEGIN
+    -- queries are run by EXECUTE without INTO, only then postgres executes them with parallel workers
+    PERFORM set_config( 'max_parallel_workers_per_gather', '0', true );
+    StartTime := clock_timestamp();
+    EXECUTE _query;
+    __serial_ms := 1000 * ( extract(epoch from clock_timestamp()) - extract(epoch from StartTime) );
+    EXECUTE _query INTO __serial_result;
+
+    PERFORM set_config( 'max_parallel_workers_per_gather', '4', true );
+    PERFORM set_config( 'parallel_setup_cost', '0', true );
+    PERFORM set_config( 'parallel_tuple_cost', '0', true );
+    PERFORM set_config( 'min_parallel_table_scan_size', '0', true );
+    StartTime := clock_timestamp();
+    EXECUTE _query;
+    __parallel_ms := 1000 * ( extract(epoch from clock_timestamp()) - extract(epoch from StartTime) );
+    EXECUTE _query INTO __parallel_result;
+    EXECUTE 'EXPLAIN ( ANALYZE, FORMAT JSON ) ' || _query INTO __plan;
+
+    INSERT INTO public.parallel_measurements VALUES( _name, __serial_result, __parallel_result, __serial_ms, __parallel_ms, __plan );
+    RAISE NOTICE 'Duration of % without parallel workers in millisecs=%, with parallel workers in millisecs=%, speedup=%', _name, __serial_ms, __parallel_ms, round( ( __serial_ms / GREATEST( __parallel_ms, 1 ) )::NUMERIC, 2 );
+    RAISE NOTICE 'Workers launched for %: %', _name, jsonb_path_query_array( __plan::jsonb, '$.**."Workers Launched"' );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    PERFORM measure_parallel_speedup( 'get_impacted_accounts', 'SELECT COUNT(*) FROM ( SELECT hive.get_impacted_accounts( ho.body ) FROM hive.operations ho ) accounts' );
+    PERFORM measure_parallel_speedup( 'get_impacted_balances', 'SELECT COUNT(*) FROM ( SELECT hive.get_impacted_balances( ho.body, TRUE ) FROM hive.operations ho ) balances' );
+    PERFORM measure_parallel_speedup( 'get_keyauths', 'SELECT COUNT(*) FROM ( SELECT hive.get_keyauths( ho.body ) FROM hive.operations ho WHERE hive.is_keyauths_operation( ho.body ) ) keyauths' );
+    PERFORM measure_parallel_speedup( 'body::jsonb', 'SELECT COUNT( ho.body::jsonb ) FROM hive.operations ho' );
+    PERFORM measure_parallel_speedup( 'get_legacy_style_operation', 'SELECT COUNT( hive.get_legacy_style_operation( ho.body ) ) FROM hive.operations ho' );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM public.parallel_measurements ) = 5, 'Not all functions were measured';
+
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.parallel_measurements pm WHERE pm.serial_result IS DISTINCT FROM pm.parallel_result
+    ), 'Parallel workers gave other results than a single process';
+
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.parallel_measurements pm WHERE NOT jsonb_path_exists( pm.plan::jsonb, '$.** ? (@."Node Type" == "Gather" && @."Workers Planned" > 0)' )
+    ), FORMAT( 'No parallel plan for %s', ( SELECT string_agg( pm.name, ', ' ) FROM public.parallel_measurements pm WHERE NOT jsonb_path_exists( pm.plan::jsonb, '$.** ? (@."Node Type" == "Gather" && @."Workers Planned" > 0)' ) ) );
+
+    ASSERT NOT EXISTS (
+        SELECT NULL FROM public.parallel_measurements pm WHERE pm.serial_result < 2500
+    ), 'Functions returned too few results';
+END
+$BODY$
+;
@@ -0,0 +1,111 @@
+DROP FUNCTION IF EXISTS test_given;
+CREATE FUNCTION test_given()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+BEGIN
+    INSERT INTO hive.operation_types
+    VALUES
+          ( 0, 'hive::protocol::vote_operation', FALSE )
+        , ( 10, 'hive::protocol::account_update_operation', FALSE )
+        , ( 80, 'hive::protocol::account_created_operation', TRUE )
+    ;
+
+    INSERT INTO hive.blocks
+    SELECT gs.num, '\xBADD10', '\xCAFE10', '2016-06-22 19:10:21-07'::timestamp, 5, '\x4007', E'[]', '\x2157', 'STM65w', 1000, 1000, 1000000, 1000, 1000, 1000, 2000, 2000
+    FROM generate_series( 1, 10000 ) gs( num )
+    ;
+
+    INSERT INTO hive.accounts( id, name, block_num )
+    VALUES (5, 'initminer', 1)
+    ;
+
+    -- one operation in each block: an account is created in every 10th block, updated in the next one, other operations are votes
+    INSERT INTO hive.operations( id, block_num, trx_in_block, op_pos, op_type_id, timestamp, body )
+    SELECT
+          ops.num
+        , ops.num
+        , 0
+        , 0
+        , CASE ops.num % 10 WHEN 0 THEN 80 WHEN 1 THEN 10 ELSE 0 END
+        , '2016-06-22 19:10:21-07'::timestamp
+        , CASE ops.num % 10
+            WHEN 0 THEN format( '{"type":"account_created_operation","value":{"new_account_name":"acc%s","creator":"initminer","initial_vesting_shares":{"amount":"0","precision":6,"nai":"@@000000037"},"initial_delegation":{"amount":"0","precision":6,"nai":"@@000000037"}}}', ops.num )
+            WHEN 1 THEN format( '{"type":"account_update_operation","value":{"account":"acc%s","posting":{"weight_threshold":1,"account_auths":[],"key_auths":[["%s",1]]},"memo_key":"STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo","json_metadata":""}}'
+                    , ops.num - 1, CASE WHEN ops.num % 20 = 1 THEN 'STM76EQNV2RTA6yF9TnBvGSV71mW7eW36MM7XQp24JxdoArTfKA76' ELSE 'STM6FATHLohxTN8RWWkU9ZZwVywXo6MEDjHHui1jEBYkG2tTdvMYo' END )
+            ELSE '{"type":"vote_operation","value":{"voter":"dantheman","author":"red","permlink":"888","weight":-100}}'
+          END::hive.operation
+    FROM generate_series( 1, 10000 ) ops( num );
+
+    ANALYZE hive.operations;
+
+    PERFORM hive.app_create_context( 'context' );
+    PERFORM hive.start_provider_accounts( 'context' );
+    PERFORM hive.start_provider_keyauth( 'context' );
+    UPDATE hive.contexts SET current_block_num = 10000, irreversible_block = 10000;
+
+    -- results of the providers computed per operation, as they were computed by SQL
+    CREATE TABLE public.expected_accounts AS
+    SELECT DISTINCT hive.get_created_from_account_create_operations( ov.body ) AS name
+    FROM hive.context_operations_view ov
+    JOIN hive.operation_types ot ON ov.op_type_id = ot.id
+    WHERE ot.name = 'hive::protocol::account_created_operation';
+
+    CREATE TABLE public.expected_keyauth AS
+    SELECT DISTINCT ON ( ka.key_auth, ka.authority_kind ) ka.*
+    FROM hive.context_operations_view ov, hive.get_keyauths( ov.body ) ka
+    WHERE hive.is_keyauths_operation( ov.body )
+    ORDER BY ka.key_auth, ka.authority_kind, ov.id;
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_when;
+CREATE FUNCTION test_when()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+VOLATILE
+AS
+$BODY$
+DECLARE
+  StartTime timestamptz;
+  __first_block INT;
+BEGIN
+    -- the blocks are replayed in ranges, as the state providers are updated by an application
+    StartTime := clock_timestamp();
+    FOR __first_block IN 1 .. 10000 BY 1000 LOOP
+        PERFORM hive.update_state_provider_accounts( __first_block, __first_block + 999, 'context' );
+    END LOOP;
+    RAISE NOTICE 'Duration of accounts state provider replay of 10000 blocks in millisecs=%', 1000 * ( extract(epoch from clock_timestamp()) - extract(epoch from StartTime) );
+
+    StartTime := clock_timestamp();
+    FOR __first_block IN 1 .. 10000 BY 1000 LOOP
+        PERFORM hive.update_state_provider_keyauth( __first_block, __first_block + 999, 'context' );
+    END LOOP;
+    RAISE NOTICE 'Duration of keyauth state provider replay of 10000 blocks in millisecs=%', 1000 * ( extract(epoch from clock_timestamp()) - extract(epoch from StartTime) );
+END;
+$BODY$
+;
+
+DROP FUNCTION IF EXISTS test_then;
+CREATE FUNCTION test_then()
+    RETURNS void
+    LANGUAGE 'plpgsql'
+STABLE
+AS
+$BODY$
+BEGIN
+    ASSERT ( SELECT COUNT(*) FROM hive.context_accounts ) = 1000, 'Wrong number of accounts';
+    ASSERT NOT EXISTS ( SELECT name FROM public.expected_accounts EXCEPT SELECT name FROM hive.context_accounts ), 'Not all accounts were created';
+
+    -- ids are given in order of creation
+    ASSERT ( SELECT name FROM hive.context_accounts ORDER BY id LIMIT 1 ) = 'acc10', 'Wrong first account';
+    ASSERT ( SELECT name FROM hive.context_accounts ORDER BY id DESC LIMIT 1 ) = 'acc10000', 'Wrong last account';
+
+    ASSERT ( SELECT COUNT(*) FROM hive.context_keyauth ) = ( SELECT COUNT(*) FROM public.expected_keyauth ), 'Wrong number of keyauths';
+    ASSERT NOT EXISTS ( SELECT * FROM public.expected_keyauth EXCEPT SELECT * FROM hive.context_keyauth ), 'Wrong keyauths';
+END
+$BODY$
+;
@@ -0,0 +1,86 @@
+#include "string_info.hpp"
+
+#include <include/psql_utils/postgres_includes.hpp>
+
+// port library of postgres is not linked to the tests
+#undef vsnprintf
+
+#include <to_json.hpp>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * StringInfo functions used by the JSON writer of hive_fork_manager, unit tests run without a postgres backend,
+ * so they are implemented here with malloc in the same way as in postgres lib/stringinfo.c
+ */
+extern "C" {
+
+void initStringInfo( StringInfo str )
+{
+  str->maxlen = 1024;
+  str->data = static_cast< char* >( malloc( str->maxlen ) );
+  str->data[ 0 ] = '\0';
+  str->len = 0;
+  str->cursor = 0;
+}
+
+void enlargeStringInfo( StringInfo str, int needed )
+{
+  needed += str->len + 1;
+  if ( needed <= str->maxlen )
+    return;
+
+  int new_length = 2 * str->maxlen;
+  while ( needed > new_length )
+    new_length *= 2;
+
+  str->data = static_cast< char* >( realloc( str->data, new_length ) );
+  str->maxlen = new_length;
+}
+
+void appendBinaryStringInfo( StringInfo str, const char* data, int datalen )
+{
+  enlargeStringInfo( str, datalen );
+  memcpy( str->data + str->len, data, datalen );
+  str->len += datalen;
+  str->data[ str->len ] = '\0';
+}
+
+void appendStringInfoChar( StringInfo str, char ch )
+{
+  appendBinaryStringInfo( str, &ch, 1 );
+}
+
+void appendStringInfo( StringInfo str, const char* fmt, ... )
+{
+  va_list args;
+  va_start( args, fmt );
+  const int needed = vsnprintf( nullptr, 0, fmt, args );
+  va_end( args );
+
+  enlargeStringInfo( str, needed );
+  va_start( args, fmt );
+  vsnprintf( str->data + str->len, needed + 1, fmt, args );
+  va_end( args );
+  str->len += needed;
+}
+
+} // extern "C"
+
+namespace mockups {
+
+std::string operation_to_json_text( const hive::protocol::operation& op, bool legacy )
+{
+  StringInfoData json;
+  initStringInfo( &json );
+  operation_to_json( op, legacy, &json );
+
+  std::string result( json.data, json.len );
+  free( json.data );
+  return result;
+}
+
+} // namespace mockups
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <hive/protocol/operations.hpp>
+
+#include <string>
+
+namespace mockups {
+
+/// text written by operation_to_json of hive_fork_manager, with postgres StringInfo functions replaced by string_info.cpp
+std::string operation_to_json_text( const hive::protocol::operation& op, bool legacy );
+
+} // namespace mockups
@@ -0,0 +1,46 @@
+#include <boost/test/unit_test.hpp>
+
+#include <corpus.hpp>
+
+#include <fc/io/json.hpp>
+
+#include <set>
+
+BOOST_AUTO_TEST_SUITE( block_generator_tests )
+
+BOOST_AUTO_TEST_CASE( same_seed_same_blocks )
+{
+  auto profile = block_generator::mainnet_profile();
+  profile.accounts = 1000;
+
+  block_generator::blocks_generator first( profile, 7, 100 );
+  block_generator::blocks_generator second( profile, 7, 100 );
+
+  for ( auto i = 0; i < 20; ++i )
+  {
+    const auto first_block = first.next_block();
+    BOOST_REQUIRE_EQUAL( first_block.block_num, 100u + i );
+    BOOST_REQUIRE_EQUAL( first_block.block.block_num(), 100u + i );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( first_block ), fc::json::to_string( second.next_block() ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( corpus_contains_all_operation_types )
+{
+  auto profile = block_generator::mainnet_profile();
+  profile.accounts = 1000;
+
+  const auto corpus = block_generator::generate_corpus( profile, 10, 7, 1 );
+
+  std::set< int64_t > types;
+  for ( const auto& operation : corpus.operations )
+    types.insert( operation.op.which() );
+  BOOST_REQUIRE_EQUAL( types.size(), static_cast< size_t >( hive::protocol::operation::count() ) );
+
+  BOOST_REQUIRE_EQUAL( corpus.blocks.size(), 10u );
+  BOOST_REQUIRE_GE( corpus.accounts.size(), profile.accounts );
+  for ( const auto& account_operation : corpus.account_operations )
+    BOOST_REQUIRE_LT( static_cast< size_t >( account_operation.account_id ), corpus.accounts.size() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,34 +21,40 @@ struct base
   }
 };
 
-hive::plugins::sql_serializer::blockchain_filter make_filter()
+hive::plugins::sql_serializer::blockchain_filter make_filter( std::stringstream& _file )
 {
   namespace po = boost::program_options;
 
   type_extractor::operation_extractor op_extractor;
   hive::plugins::sql_serializer::blockchain_filter filter( true, op_extractor );
 
-  std::stringstream _file;
-  _file<<"psql-track-body-operations = ";
-  _file<<"[\"custom_json_operation\",";
-  _file<<R"("\"id\":.*\"podping\"|\"id\":.*\"pp_video_update\"|\"id\":.*\"ssc-mainnet-hive\"")";
-  _file<<"]";
-
   po::options_description desc("");
   desc.add_options()
     ("psql-track-account-range", boost::program_options::value< std::vector<std::string> >()->composing()->multitoken(), "")
     ("psql-track-operations", boost::program_options::value< std::vector<std::string> >()->composing(), "")
-    ("psql-track-body-operations", boost::program_options::value< std::vector<std::string> >()->composing()->multitoken(), "");
+    ("psql-track-body-operations", boost::program_options::value< std::vector<std::string> >()->composing()->multitoken(), "")
+    ("psql-track-operation-predicates", boost::program_options::value< std::vector<std::string> >()->composing(), "");
 
   po::variables_map vm;
 
   po::store( po::parse_config_file( _file, desc, true ), vm );
 
-  filter.fill( vm, "psql-track-account-range", "psql-track-operations", "psql-track-body-operations" );
+  filter.fill( vm, "psql-track-account-range", "psql-track-operations", "psql-track-body-operations", "psql-track-operation-predicates" );
 
   return filter;
 }
 
+hive::plugins::sql_serializer::blockchain_filter make_filter()
+{
+  std::stringstream _file;
+  _file<<"psql-track-body-operations = ";
+  _file<<"[\"custom_json_operation\",";
+  _file<<R"("\"id\":.*\"podping\"|\"id\":.*\"pp_video_update\"|\"id\":.*\"ssc-mainnet-hive\"")";
+  _file<<"]";
+
+  return make_filter( _file );
+}
+
 bool is_tracked_operation_complex( const hive::plugins::sql_serializer::blockchain_filter& filter, const std::string& json )
 {
   hive::protocol::custom_json_operation op;
@@ -93,4 +99,99 @@ BOOST_AUTO_TEST_CASE( body_operation_00 )
   BOOST_REQUIRE_EQUAL( is_tracked_operation_complex( filter, _op_body_complex ), false );
 }
 
+BOOST_AUTO_TEST_CASE( account_range_00 )
+{
+  BOOST_TEST_MESSAGE( "Testing: overlapping and single account ranges" );
+
+  std::stringstream _file;
+  _file<<R"(psql-track-account-range = ["b","back"])"<<"\n";
+  _file<<R"(psql-track-account-range = ["ba","bz"])"<<"\n";
+  _file<<R"(psql-track-account-range = ["gtg","gtg"])"<<"\n";
+
+  auto filter = make_filter( _file );
+
+  BOOST_REQUIRE( filter.is_enabled() );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "b" ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "back" ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "blocktrades" ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "bz" ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "bzz" ), false );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "a" ), false );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "gtg" ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "gtga" ), false );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "gt" ), false );
+}
+
+BOOST_AUTO_TEST_CASE( operation_type_00 )
+{
+  BOOST_TEST_MESSAGE( "Testing: types of operations and accepted transactions" );
+
+  std::stringstream _file;
+  _file<<"psql-track-operations = transfer_operation\n";
+  _file<<"psql-track-operations = author_reward_operation\n";
+
+  auto filter = make_filter( _file );
+
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( hive::protocol::transfer_operation() ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( hive::protocol::author_reward_operation() ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( hive::protocol::vote_operation() ), false );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_account( "anyone" ), true );
+
+  filter.remember_trx_id( 3 );
+  filter.remember_trx_id( -1 );
+  BOOST_REQUIRE_EQUAL( filter.is_trx_accepted( 3 ), true );
+  BOOST_REQUIRE_EQUAL( filter.is_trx_accepted( 2 ), false );
+  BOOST_REQUIRE_EQUAL( filter.is_trx_accepted( 1000 ), false );
+
+  filter.clear();
+  BOOST_REQUIRE_EQUAL( filter.is_trx_accepted( 3 ), false );
+}
+
+BOOST_AUTO_TEST_CASE( operation_predicate_00 )
+{
+  BOOST_TEST_MESSAGE( "Testing: predicates on fields of operations" );
+
+  std::stringstream _file;
+  _file<<R"(psql-track-operation-predicates = custom_json_operation.id in ["podping","pp_video_update"])"<<"\n";
+  _file<<R"(psql-track-operation-predicates = custom_json.required_posting_auths == "gtg")"<<"\n";
+  _file<<R"(psql-track-operation-predicates = transfer_operation.memo prefix "scam")"<<"\n";
+
+  auto filter = make_filter( _file );
+
+  BOOST_REQUIRE_EQUAL( is_tracked_operation( filter, "podping" ), true );
+  BOOST_REQUIRE_EQUAL( is_tracked_operation( filter, "pp_video_update" ), true );
+  BOOST_REQUIRE_EQUAL( is_tracked_operation( filter, "ssc-mainnet-hive" ), false );
+
+  hive::protocol::custom_json_operation _custom_json;
+  _custom_json.id = "storage";
+  _custom_json.required_posting_auths.insert( "nettybot" );
+  _custom_json.required_posting_auths.insert( "gtg" );
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( _custom_json ), true );
+
+  hive::protocol::transfer_operation _transfer;
+  _transfer.memo = "scam: send me 1 HIVE";
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( _transfer ), true );
+  _transfer.memo = "no scam";
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( _transfer ), false );
+
+  BOOST_REQUIRE_EQUAL( filter.is_tracked_operation( hive::protocol::vote_operation() ), false );
+}
+
+BOOST_AUTO_TEST_CASE( operation_predicate_01 )
+{
+  BOOST_TEST_MESSAGE( "Testing: invalid predicates" );
+
+  std::stringstream _unknown_type;
+  _unknown_type<<R"(psql-track-operation-predicates = custom_jsonx_operation.id == "podping")";
+  BOOST_REQUIRE_THROW( make_filter( _unknown_type ), fc::exception );
+
+  std::stringstream _unknown_field;
+  _unknown_field<<R"(psql-track-operation-predicates = custom_json_operation.identifier == "podping")";
+  BOOST_REQUIRE_THROW( make_filter( _unknown_field ), fc::exception );
+
+  std::stringstream _unknown_matcher;
+  _unknown_matcher<<R"(psql-track-operation-predicates = custom_json_operation.id like "podping")";
+  BOOST_REQUIRE_THROW( make_filter( _unknown_matcher ), fc::exception );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,47 @@
+#include <boost/test/unit_test.hpp>
+
+#include <blocks_generator.hpp>
+
+#include <hive/plugins/sql_serializer/impacted_accounts_extractor.hpp>
+
+#include <hive/chain/util/impacted.hpp>
+
+BOOST_AUTO_TEST_SUITE( impacted_accounts_extractor_tests )
+
+BOOST_AUTO_TEST_CASE( same_accounts_as_chain_thread )
+{
+  auto profile = block_generator::mainnet_profile();
+  profile.accounts = 1000;
+  block_generator::blocks_generator generator( profile, 11, 1 );
+
+  hive::plugins::sql_serializer::impacted_accounts_extractor extractor( 3 );
+
+  for ( auto block_num = 0; block_num < 10; ++block_num )
+  {
+    const auto generated = generator.next_block( block_num == 9 );
+    const auto full_block = hive::chain::full_block_type::create_from_signed_block( generated.block );
+
+    extractor.start_block( full_block );
+
+    for ( size_t trx_in_block = 0; trx_in_block < generated.block.transactions.size(); ++trx_in_block )
+    {
+      const auto& operations = generated.block.transactions[ trx_in_block ].operations;
+      for ( uint32_t op_in_trx = 0; op_in_trx < operations.size(); ++op_in_trx )
+      {
+        hive::plugins::sql_serializer::impacted_accounts_extractor::impacted_t expected;
+        hive::app::operation_get_impacted_accounts( operations[ op_in_trx ], expected );
+
+        const auto* impacted = extractor.get( trx_in_block, op_in_trx );
+        BOOST_REQUIRE( impacted != nullptr );
+        BOOST_REQUIRE( *impacted == expected );
+      }
+      BOOST_REQUIRE( extractor.get( trx_in_block, operations.size() ) == nullptr );
+    }
+    BOOST_REQUIRE( extractor.get( generated.block.transactions.size(), 0 ) == nullptr );
+    BOOST_REQUIRE( extractor.get( -1, 0 ) == nullptr );
+
+    extractor.finish_block();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
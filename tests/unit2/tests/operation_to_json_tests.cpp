@@ -0,0 +1,124 @@
+#include <boost/test/unit_test.hpp>
+
+#include <corpus.hpp>
+#include <string_info.hpp>
+
+#include <hive/protocol/operations.hpp>
+
+#include <fc/io/json.hpp>
+
+#include <set>
+
+namespace {
+
+  using hive::protocol::serialization_mode_controller;
+  using hive::protocol::transaction_serialization_type;
+
+  /// text of the operation which was returned by operation_out and hive.get_legacy_style_operation before the writer replaced fc
+  std::string fc_json_text( const hive::protocol::operation& op, bool legacy )
+  {
+    if ( !legacy )
+      return fc::json::to_string( op );
+
+    serialization_mode_controller::mode_guard guard( transaction_serialization_type::legacy );
+    return fc::json::to_string( op );
+  }
+
+  void require_fc_text( const hive::protocol::operation& op )
+  {
+    BOOST_REQUIRE_EQUAL( mockups::operation_to_json_text( op, false ), fc_json_text( op, false ) );
+    BOOST_REQUIRE_EQUAL( mockups::operation_to_json_text( op, true ), fc_json_text( op, true ) );
+  }
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( operation_to_json_tests )
+
+BOOST_AUTO_TEST_CASE( all_operation_types_as_fc_writes_them )
+{
+  auto profile = block_generator::mainnet_profile();
+  profile.accounts = 1000;
+
+  const auto corpus = block_generator::generate_corpus( profile, 10, 7, 1 );
+
+  std::set< int64_t > types;
+  for ( const auto& operation : corpus.operations )
+  {
+    require_fc_text( operation.op );
+    types.insert( operation.op.which() );
+  }
+  BOOST_REQUIRE_EQUAL( types.size(), static_cast< size_t >( hive::protocol::operation::count() ) );
+}
+
+BOOST_AUTO_TEST_CASE( integers_wider_than_32_bits_as_fc_writes_them )
+{
+  hive::protocol::pow_operation pow;
+  pow.worker_account = std::string( "alice" );
+  pow.nonce = 0xffffffffull;
+  require_fc_text( pow );
+  pow.nonce = 0x100000001ull;
+  require_fc_text( pow );
+
+  hive::protocol::effective_comment_vote_operation vote;
+  vote.voter = std::string( "alice" );
+  vote.author = std::string( "bob" );
+  vote.permlink = std::string( "permlink" );
+  vote.weight = 5'000'000'000ull;
+  vote.total_vote_weight = 5'000'000'000ull;
+  vote.rshares = 5'000'000'000ll;
+  require_fc_text( vote );
+  vote.rshares = -5'000'000'000ll;
+  require_fc_text( vote );
+  vote.rshares = -1;
+  require_fc_text( vote );
+}
+
+BOOST_AUTO_TEST_CASE( empty_optionals_as_fc_writes_them )
+{
+  hive::protocol::account_update_operation update;
+  update.account = std::string( "alice" );
+  update.json_metadata = std::string( "{}" );
+  require_fc_text( update );
+
+  hive::protocol::authority posting;
+  posting.weight_threshold = 1;
+  posting.add_authority( hive::protocol::account_name_type( std::string( "bob" ) ), 1 );
+  update.posting = posting;
+  require_fc_text( update );
+
+  hive::protocol::pow2_operation pow2;
+  require_fc_text( pow2 );
+}
+
+BOOST_AUTO_TEST_CASE( control_characters_as_fc_writes_them )
+{
+  hive::protocol::transfer_operation transfer;
+  transfer.from = std::string( "alice" );
+  transfer.to = std::string( "bob" );
+  transfer.memo = "\x01\x02\x1f" "\b\f\n\r\t" "\"\\/ end \xc5\xbc\xc3\xb3\xc5\x82w";
+  require_fc_text( transfer );
+}
+
+BOOST_AUTO_TEST_CASE( nested_static_variants_as_fc_writes_them )
+{
+  hive::protocol::pow2_operation pow2;
+  hive::protocol::pow2 work;
+  work.input.worker_account = std::string( "alice" );
+  work.input.nonce = 0x100000001ull;
+  work.pow_summary = 3858814423u;
+  pow2.work = work;
+  require_fc_text( pow2 );
+
+  pow2.work = hive::protocol::equihash_pow();
+  require_fc_text( pow2 );
+
+  hive::protocol::comment_options_operation options;
+  options.author = std::string( "alice" );
+  options.permlink = std::string( "permlink" );
+  hive::protocol::comment_payout_beneficiaries beneficiaries;
+  beneficiaries.beneficiaries.push_back( hive::protocol::beneficiary_route_type( hive::protocol::account_name_type( std::string( "bob" ) ), 5000 ) );
+  options.extensions.insert( beneficiaries );
+  require_fc_text( options );
+}
+
+BOOST_AUTO_TEST_SUITE_END()